@@ -0,0 +1,78 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_CLOSED_FORMS_H
+#define RATATOSKR_CLOSED_FORMS_H
+#include "differentialcomplex.h"
+#include "grading.h"
+#include "../linearalgebra/blocks.h"
+namespace ratatoskr {
+using namespace GiNaC;
+using namespace Wedge;
+
+/** @brief The closed p-forms on a Lie algebra with rational structure constants, together with a complement spanned by elements of the basis of p-forms
+ *
+ * The kernel of d is computed one weight at a time, since d preserves the weight of forms, using up to the given number of workers for large weight spaces. The complement consists of the forms e^A such that
+ * e^A is not the free column of an element of the kernel. It is printed in the same format as the VectorSpace returned by LieGroup::ClosedForms.
+ */
+struct ClosedFormsSplitting {
+	exvector closed, complement;
+};
+
+inline ClosedFormsSplitting closed_forms(const LieGroup& G, const StructureConstants& c, int p, int workers=1) {
+	auto forms=p_forms(G,p);
+	auto d=differential_matrix(BitmaskDifferential{c},p);
+	Grading grading{c};
+	vector<Grading::Weight> weights;
+	for (auto A: p_form_masks(G.Dimension(),p)) weights.push_back(grading.weight(A));
+	auto blocks=enumerate_distinct<Grading::Weight,Grading::WeightLess>(weights);
+	ClosedFormsSplitting result;
+	set<int> free_columns;
+	for (auto& v: block_kernel(d,blocks,workers)) {
+		ex form;
+		for (auto& entry: v) form+=entry.second*forms[entry.first];
+		result.closed.push_back(form);
+		free_columns.insert(v.rbegin()->first);	//the free column is the last nonzero entry
+	}
+	for (int j=0;j<forms.size();++j)
+		if (!free_columns.count(j)) result.complement.push_back(forms[j]);
+	return result;
+}
+
+namespace detail {
+	inline void print_basis(ostream& os, const exvector& basis) {
+		if (basis.empty()) os<<"No elements";
+		else {
+			os<<"{{"<<endl;
+			for (auto& x: basis) os<<x<<endl;
+			os<<"}}";
+		}
+	}
+}
+
+inline ostream& operator<<(ostream& os, const ClosedFormsSplitting& splitting) {
+	os<<"Subspace:";
+	detail::print_basis(os,splitting.closed);
+	os<<endl<<"Complement:";
+	detail::print_basis(os,splitting.complement);
+	return os;
+}
+
+}
+#endif
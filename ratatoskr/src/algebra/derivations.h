@@ -0,0 +1,72 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_DERIVATIONS_H
+#define RATATOSKR_DERIVATIONS_H
+#include "grading.h"
+#include "../linearalgebra/blocks.h"
+namespace ratatoskr {
+using namespace GiNaC;
+using namespace Wedge;
+
+/** @brief A basis of the space of derivations of a Lie algebra without parameters
+ *
+ * Each derivation is represented by the matrix D such that De_j=\sum_i D_{ij}e_i. The equations D[e_i,e_j]=[De_i,e_j]+[e_i,De_j]
+ * are linear in the n^2 entries of D; they split into blocks according to the grading of the Lie algebra, which are solved by modular methods
+ * if the structure constants are rational, and by symbolic elimination otherwise. Large blocks are distributed over up to the given number of workers.
+ */
+inline vector<matrix> derivation_matrices(const StructureConstants& c, int workers=1) {
+	int n=c.Dimension();
+	vector<ex> bracket(n*n*n);
+	auto b=[&bracket,n] (int i, int j, int k) -> ex& {return bracket[(i*n+j)*n+k];};
+	for (auto& triple: c.triples()) {
+		b(triple.i-1,triple.j-1,triple.k-1)=-triple.c;
+		b(triple.j-1,triple.i-1,triple.k-1)=triple.c;
+	}
+	auto unknown=[n] (int i, int j) {return i*n+j;};
+	SparseMatrix equations(n*n);
+	for (int i=0;i<n;++i)
+	for (int j=i+1;j<n;++j)
+	for (int k=0;k<n;++k) {
+		SparseVector row;
+		for (int m=0;m<n;++m) {
+			row[unknown(k,m)]+=b(i,j,m);
+			row[unknown(m,i)]-=b(m,j,k);
+			row[unknown(m,j)]-=b(i,m,k);
+		}
+		equations.add_row(std::move(row));
+	}
+	//the equations are homogeneous for the grading, the entry D_{ij} having weight w_i-w_j
+	Grading grading{c};
+	vector<Grading::Weight> weights;
+	for (int i=0;i<n;++i)
+	for (int j=0;j<n;++j)
+		weights.push_back(grading.endomorphism_weight(i,j));
+	auto blocks=enumerate_distinct<Grading::Weight,Grading::WeightLess>(weights);
+	vector<matrix> result;
+	for (auto& v: block_kernel(equations,blocks,workers)) {
+		matrix D(n,n);
+		for (auto& entry: v) D(entry.first/n,entry.first%n)=entry.second;
+		result.push_back(std::move(D));
+	}
+	return result;
+}
+
+}
+#endif
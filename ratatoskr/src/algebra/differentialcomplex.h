@@ -0,0 +1,154 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_DIFFERENTIAL_COMPLEX_H
+#define RATATOSKR_DIFFERENTIAL_COMPLEX_H
+#include "../linearalgebra/sparsematrix.h"
+#include "../linearalgebra/zerotest.h"
+#include "../forms/bitmaskform.h"
+#include "structureconstants.h"
+namespace ratatoskr {
+using namespace GiNaC;
+using namespace Wedge;
+
+/** @brief The exterior derivative on forms of a Lie algebra, computed from the table of structure constants
+ *
+ * Forms are represented as BitmaskForm objects, where the bit i-1 corresponds to e^i; d is the antiderivation extending de^k=\sum c^k_{ij}e^{ij}.
+ */
+class BitmaskDifferential {
+	vector<BitmaskForm> de;
+public:
+	explicit BitmaskDifferential(const StructureConstants& c) : de(c.Dimension()) {
+		if (c.Dimension()>64) throw std::invalid_argument("BitmaskDifferential: dimension greater than 64");
+		for (auto& triple: c.triples())
+			de[triple.k-1].add((FormMask{1}<<(triple.i-1))|(FormMask{1}<<(triple.j-1)),triple.c);
+	}
+	int Dimension() const {return de.size();}
+	BitmaskForm operator()(const BitmaskForm& form) const {
+		return extend_to_derivation(form,de,true);
+	}
+};
+
+//the masks of the basis e^{i_1\dots i_p}, i_1<\dots<i_p, of p-forms in dimension n, in lexicographic order; empty unless 0\leq p\leq n
+inline vector<FormMask> p_form_masks(int n, int p) {
+	vector<FormMask> result;
+	if (p<0 || p>n) return result;
+	vector<int> indices(p);
+	for (int i=0;i<p;++i) indices[i]=i;
+	while (true) {
+		FormMask A=0;
+		for (int i: indices) A|=FormMask{1}<<i;
+		result.push_back(A);
+		int k=p-1;
+		while (k>=0 && indices[k]==n-p+k) --k;
+		if (k<0) return result;
+		++indices[k];
+		for (int i=k+1;i<p;++i) indices[i]=indices[i-1]+1;
+	}
+}
+
+//the basis e^{i_1\dots i_p}, i_1<\dots<i_p, of p-forms on G, in the same order as p_form_masks
+inline exvector p_forms(const LieGroup& G, int p) {
+	exvector one_forms(G.e().begin(),G.e().end());
+	exvector result;
+	for (auto A: p_form_masks(G.Dimension(),p)) result.push_back(BitmaskForm{A}.to_ex(one_forms));
+	return result;
+}
+
+//the images under d of the basis of p-forms, each given by its components relative to the basis of (p+1)-forms
+inline vector<SparseVector> differentials_of_p_forms(const BitmaskDifferential& d, int p) {
+	int n=d.Dimension();
+	map<FormMask,int> index;
+	for (auto A: p_form_masks(n,p+1)) index.emplace(A,index.size());
+	vector<SparseVector> result;
+	for (auto A: p_form_masks(n,p)) {
+		SparseVector v;
+		for (auto& component: d(BitmaskForm{A}).Components()) v.emplace(index[component.first],component.second);
+		result.push_back(std::move(v));
+	}
+	return result;
+}
+
+/** @brief The matrix of the Chevalley-Eilenberg differential d:\Lambda^p\to\Lambda^{p+1} relative to the bases of p_form_masks
+ *
+ * Column j contains the components of d applied to the j-th p-form.
+ */
+inline SparseMatrix differential_matrix(const BitmaskDifferential& d, int p) {
+	auto columns=differentials_of_p_forms(d,p);
+	vector<SparseVector> rows(binomial(numeric{d.Dimension()},numeric{p+1}).to_int());
+	for (int j=0;j<columns.size();++j)
+		for (auto& entry: columns[j]) rows[entry.first][j]=entry.second;
+	SparseMatrix result(columns.size());
+	for (auto& row: rows) result.add_row(std::move(row));
+	return result;
+}
+
+
+namespace detail {
+	//the least k such that d(de^k) has a component which is not zero according to is_zero, or 0 if there is none
+	template<typename IsZero>
+	int first_nonclosed_differential(const StructureConstants& c, IsZero&& is_zero) {
+		BitmaskDifferential d{c};
+		for (int k=0;k<c.Dimension();++k)
+			for (auto& component: d(d(BitmaskForm{FormMask{1}<<k})).Components())
+				if (!is_zero(component.second)) return k+1;
+		return 0;
+	}
+	inline exset symbols_in(const StructureConstants& c) {
+		exset result;
+		for (auto& triple: c.triples()) {
+			auto symbols=ratatoskr::symbols_in(triple.c);
+			result.insert(symbols.begin(),symbols.end());
+		}
+		return result;
+	}
+	inline StructureConstants substitute(const StructureConstants& c, const exmap& point) {
+		auto triples=c.triples();
+		for (auto& triple: triples) triple.c=triple.c.subs(point);
+		return StructureConstants{c.Dimension(),std::move(triples)};
+	}
+}
+
+/** @brief The least k such that d(de^k) is not zero, or 0 if the structure constants satisfy the Jacobi identity
+ *
+ * If the structure constants depend on parameters, d^2 is first evaluated at a few random rational values of the parameters, and the symbolic computation is only
+ * carried out to confirm a nonzero value; thus, Lie algebras depending on parameters satisfying Jacobi for random values of the parameters are accepted.
+ */
+inline int jacobi_violation(const StructureConstants& c) {
+	ZeroTest zero_test;
+	auto is_zero=[&zero_test] (const ex& x) {return zero_test.is_zero(x);};
+	auto symbols=detail::symbols_in(c);
+	if (symbols.empty()) return detail::first_nonclosed_differential(c,is_zero);
+	const int points=3, attempts=10;
+	mt19937_64 engine;
+	int evaluated=0;
+	for (int attempt=0;attempt<attempts && evaluated<points;++attempt) {
+		try {
+			if (detail::first_nonclosed_differential(detail::substitute(c,random_rational_point(symbols,engine)),is_zero)) break;
+		}
+		catch (const std::exception&) {
+			continue;	//the point is a pole of some structure constant
+		}
+		++evaluated;
+	}
+	return evaluated==points? 0 : detail::first_nonclosed_differential(c,is_zero);
+}
+
+}
+#endif
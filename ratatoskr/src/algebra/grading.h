@@ -0,0 +1,81 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_GRADING_H
+#define RATATOSKR_GRADING_H
+#include "../linearalgebra/modular.h"
+#include "../forms/bitmaskform.h"
+namespace ratatoskr {
+using namespace GiNaC;
+using namespace Wedge;
+
+/** @brief The finest grading of a Lie algebra for which the elements of the frame are homogeneous
+ *
+ * The weights are the solutions of w_k=w_i+w_j for each nonzero structure constant c^k_{ij}; the weight of e_i is represented by its components
+ * w_i relative to a basis of the space of solutions. Two elements have the same weight for every such grading if and only if they have the same Weight.
+ */
+class Grading {
+public:
+	using Weight=vector<numeric>;
+	struct WeightLess {
+		bool operator()(const Weight& v, const Weight& w) const {
+			return lexicographical_compare(v.begin(),v.end(),w.begin(),w.end(),[] (const numeric& x, const numeric& y) {return x<y;});
+		}
+	};
+private:
+	vector<Weight> weights;
+public:
+	explicit Grading(const StructureConstants& c) : weights(c.Dimension()) {
+		SparseMatrix equations(c.Dimension());
+		for (auto& triple: c.triples()) {
+			SparseVector row;
+			row[triple.i-1]+=1;
+			row[triple.j-1]+=1;
+			row[triple.k-1]-=1;
+			equations.add_row(std::move(row));
+		}
+		for (auto& v: exact_kernel(equations))
+			for (int i=0;i<weights.size();++i) {
+				auto entry=v.find(i);
+				weights[i].push_back(entry==v.end()? numeric{0} : ex_to<numeric>(entry->second));
+			}
+	}
+	//the dimension of the space of gradings; the grading is trivial if it is zero
+	int Rank() const {return weights.empty()? 0 : weights[0].size();}
+	//the weight of e_{i+1}
+	const Weight& weight(int i) const {return weights[i];}
+	//the weight of the form e^A
+	Weight weight(FormMask A) const {
+		Weight result(Rank());
+		for (;A;A&=A-1) result=sum(result,weights[lowest_index(A)],1);
+		return result;
+	}
+	//the weight of a homogeneous endomorphism mapping e_j to a multiple of e_i
+	Weight endomorphism_weight(int i, int j) const {
+		return sum(weights[i],weights[j],-1);
+	}
+	static Weight sum(const Weight& v, const Weight& w, int sign) {
+		Weight result(v.size());
+		for (int l=0;l<v.size();++l) result[l]=v[l]+numeric{sign}*w[l];
+		return result;
+	}
+};
+
+}
+#endif
@@ -0,0 +1,127 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_INVARIANTS_H
+#define RATATOSKR_INVARIANTS_H
+#include "../linearalgebra/sparsematrix.h"
+#include "../linearalgebra/zerotest.h"
+#include "structureconstants.h"
+namespace ratatoskr {
+using namespace GiNaC;
+using namespace Wedge;
+
+/** @brief Invariants of a Lie algebra that can be computed cheaply from its structure constants
+ *
+ * Only brackets of sparse vectors and row reductions of matrices with at most dim^2 rows are involved, so that these invariants can be used to
+ * discard Lie algebras before running expensive computations. Steps of the lower central and derived series are zero if the series does not reach zero.
+ */
+struct LieAlgebraInvariants {
+	int dimension;
+	int derived_dimension;	//dimension of [g,g]
+	int centre_dimension;
+	int nilpotency_step;	//the least s such that g^{s+1}=0, where g^1=g and g^{k+1}=[g,g^k]
+	int derived_length;	//the least s such that g^{(s)}=0, where g^{(0)}=g and g^{(k+1)}=[g^{(k)},g^{(k)}]
+	bool unimodular;	//true if tr ad X=0 for all X
+	bool abelian() const {return derived_dimension==0;}
+	bool nilpotent() const {return nilpotency_step>0 || dimension==0;}
+	bool solvable() const {return derived_length>0 || dimension==0;}
+};
+
+/** @brief Brackets of sparse vectors, with 0-based indices, computed from a table of structure constants */
+class SparseBracket {
+	int dimension;
+	map<pair<int,int>,SparseVector> brackets;	//nonzero [e_i,e_j] for i<j
+public:
+	explicit SparseBracket(const StructureConstants& c) : dimension{c.Dimension()} {
+		for (auto& triple: c.triples())
+			brackets[{triple.i-1,triple.j-1}][triple.k-1]-=triple.c;
+	}
+	SparseVector operator()(int i, int j) const {
+		if (i==j) return {};
+		auto it=brackets.find({min(i,j),max(i,j)});
+		if (it==brackets.end()) return {};
+		if (i<j) return it->second;
+		SparseVector result;
+		for (auto& entry: it->second) result[entry.first]=-entry.second;
+		return result;
+	}
+	SparseVector operator()(const SparseVector& v, const SparseVector& w) const {
+		SparseVector result;
+		for (auto& x: v)
+		for (auto& y: w)
+			for (auto& entry: (*this)(x.first,y.first))
+				result[entry.first]+=x.second*y.second*entry.second;
+		return result;
+	}
+	//a basis of the span of [v,w] for v in V and w in W
+	vector<SparseVector> bracket_of_subspaces(const vector<SparseVector>& V, const vector<SparseVector>& W) const {
+		SparseMatrix m{dimension};
+		for (auto& v: V)
+		for (auto& w: W)
+			m.add_row((*this)(v,w));
+		vector<SparseVector> result;
+		for (auto& pivot: m.ReducedRowEchelonForm()) result.push_back(std::move(pivot.second));
+		return result;
+	}
+};
+
+namespace detail {
+	//the step at which the series V_0=g, V_{k+1}=[W,V_k] vanishes, where W=g (lower central series) or W=V_k (derived series), or 0 if it stabilizes
+	template<typename Next>
+	int vanishing_step(vector<SparseVector> V, Next&& next) {
+		int step=0;
+		while (!V.empty()) {
+			auto W=next(V);
+			if (W.size()==V.size()) return 0;
+			V=std::move(W);
+			++step;
+		}
+		return step;
+	}
+}
+
+inline LieAlgebraInvariants lie_algebra_invariants(const StructureConstants& c) {
+	int n=c.Dimension();
+	SparseBracket bracket{c};
+	vector<SparseVector> g;
+	for (int i=0;i<n;++i) g.push_back({{i,1}});
+	LieAlgebraInvariants result;
+	result.dimension=n;
+	result.derived_dimension=bracket.bracket_of_subspaces(g,g).size();
+	//X=\sum x_ie_i is central if and only if \sum_i x_i[e_i,e_j]=0 for all j; the rows are indexed by (j,k), the columns by i
+	map<pair<int,int>,SparseVector> ad;
+	vector<ex> trace(n);
+	for (int i=0;i<n;++i)
+	for (int j=0;j<n;++j)
+		for (auto& entry: bracket(i,j)) {
+			ad[{j,entry.first}][i]=entry.second;
+			if (entry.first==j) trace[i]+=entry.second;
+		}
+	SparseMatrix centre{n};
+	for (auto& row: ad) centre.add_row(row.second);
+	result.centre_dimension=n-centre.Rank();
+	result.nilpotency_step=detail::vanishing_step(g,[&bracket,&g] (auto& V) {return bracket.bracket_of_subspaces(g,V);});
+	result.derived_length=detail::vanishing_step(g,[&bracket] (auto& V) {return bracket.bracket_of_subspaces(V,V);});
+	ZeroTest zero_test;
+	result.unimodular=all_of(trace.begin(),trace.end(),[&zero_test] (const ex& x) {return zero_test.is_zero(x);});
+	return result;
+}
+
+}
+#endif
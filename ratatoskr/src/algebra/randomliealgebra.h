@@ -0,0 +1,180 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_RANDOM_LIE_ALGEBRA_H
+#define RATATOSKR_RANDOM_LIE_ALGEBRA_H
+#include <random>
+#include "../forms/bitmaskform.h"
+#include "structureconstants.h"
+namespace ratatoskr {
+using namespace GiNaC;
+using namespace Wedge;
+
+//a differential form with integer coefficients, indexed by bitmasks as in BitmaskForm
+using IntegerForm=map<FormMask,int64_t>;
+
+inline void add(IntegerForm& form, FormMask A, int64_t coefficient) {
+	auto& c=form[A];
+	c+=coefficient;
+	if (!c) form.erase(A);
+}
+
+inline IntegerForm wedge(const IntegerForm& alpha, const IntegerForm& beta) {
+	IntegerForm result;
+	for (auto& x : alpha)
+	for (auto& y : beta)
+		if (!(x.first&y.first)) add(result,x.first|y.first,wedge_sign(x.first,y.first)*x.second*y.second);
+	return result;
+}
+
+enum class RandomLieAlgebraType {nilpotent, solvable, metric};
+
+/** @brief Generator of random Lie algebras satisfying the Jacobi identity by construction, using integer arithmetic only
+ *
+ * Lie algebras are represented by the differentials de^1,...,de^n with integer coefficients. Nilpotent Lie algebras are constructed as sequences of central extensions,
+ * where each de^k is a random combination of closed 2-forms in e^1,...,e^{k-1}, namely the exact forms de^j and the closed forms e^{ij}; each of these is taken with
+ * probability equal to the density. Solvable Lie algebras are extensions of graded nilpotent Lie algebras by the grading derivation; metric Lie algebras are cotangent
+ * extensions h\ltimes h^* of nilpotent Lie algebras, with the natural ad-invariant metric of neutral signature.
+ *
+ * The random numbers are obtained directly from std::mt19937_64 rather than from distributions, whose implementation is library-dependent, so that the output
+ * only depends on the seed.
+ */
+class RandomLieAlgebraGenerator {
+	mt19937_64 engine;
+	double density;
+	bool pick() {
+		return (engine()>>11)*0x1.0p-53<density;
+	}
+	int64_t random_coefficient() {
+		static constexpr int64_t coefficients[]={-2,-1,1,2};
+		return coefficients[engine()%4];
+	}
+	static bool is_closed(const vector<IntegerForm>& de, int i, int j) {
+		IntegerForm ei{{FormMask{1}<<i,1}}, ej{{FormMask{1}<<j,1}};
+		auto d_eij=wedge(de[i],ej);
+		for (auto& term : wedge(ei,de[j])) add(d_eij,term.first,-term.second);
+		return d_eij.empty();
+	}
+	/* a random nilpotent Lie algebra; if weights is not null, each de^k is homogeneous with respect to the weights, which are assigned as positive integers,
+	 * so that the diagonal endomorphism with entries given by the weights is a derivation */
+	vector<IntegerForm> nilpotent(int dimension, vector<int>* weights=nullptr) {
+		vector<IntegerForm> de(dimension);
+		vector<FormMask> closed;
+		if (weights) weights->assign(dimension,0);
+		for (int k=0;k<dimension;++k) {
+			vector<pair<IntegerForm,int>> summands;
+			for (auto A : closed)
+				if (pick()) summands.emplace_back(IntegerForm{{A,1}},weights? (*weights)[lowest_index(A)]+(*weights)[lowest_index(A&(A-1))] : 0);
+			for (int j=0;j<k;++j)
+				if (!de[j].empty() && pick()) summands.emplace_back(de[j],weights? (*weights)[j] : 0);
+			if (weights && !summands.empty()) {
+				int weight=summands[engine()%summands.size()].second;
+				summands.erase(remove_if(summands.begin(),summands.end(),[weight] (auto& summand) {return summand.second!=weight;}),summands.end());
+			}
+			for (auto& summand : summands) {
+				auto c=random_coefficient();
+				for (auto& term : summand.first) add(de[k],term.first,c*term.second);
+			}
+			if (weights) (*weights)[k]=de[k].empty()? 1+engine()%2 : summands[0].second;
+			for (int i=0;i<k;++i)
+				if (is_closed(de,i,k)) closed.push_back((FormMask{1}<<i)|(FormMask{1}<<k));
+		}
+		return de;
+	}
+	vector<IntegerForm> solvable(int dimension) {
+		vector<int> weights;
+		auto de=nilpotent(dimension-1,&weights);
+		de.emplace_back();
+		auto t=random_coefficient();
+		FormMask last=FormMask{1}<<(dimension-1);
+		for (int k=0;k<dimension-1;++k)
+			add(de[k],(FormMask{1}<<k)|last,-t*weights[k]);
+		return de;
+	}
+	vector<IntegerForm> metric(int dimension) {
+		int m=dimension/2;
+		auto de=nilpotent(m);
+		de.resize(dimension);
+		//if [e_i,e_j]=-c^l_{ij}e_l, then [e_i,f_l]=\sum_j c^l_{ij}f_j, where f_l=e_{m+l} is the dual basis
+		for (int l=0;l<m;++l)
+			for (auto& term : de[l]) {
+				int a=lowest_index(term.first), b=lowest_index(term.first&(term.first-1));
+				add(de[m+b],(FormMask{1}<<a)|(FormMask{1}<<(m+l)),-term.second);
+				add(de[m+a],(FormMask{1}<<b)|(FormMask{1}<<(m+l)),term.second);
+			}
+		return de;
+	}
+public:
+	RandomLieAlgebraGenerator(uint64_t seed, double density) : engine{seed}, density{density} {}
+	//the differentials of a random Lie algebra of the given type; metric Lie algebras have even dimension
+	vector<IntegerForm> operator()(RandomLieAlgebraType type, int dimension) {
+		if (dimension<1 || dimension>64) throw std::invalid_argument("random Lie algebras should have dimension between 1 and 64");
+		switch (type) {
+			case RandomLieAlgebraType::nilpotent: return nilpotent(dimension);
+			case RandomLieAlgebraType::solvable: return solvable(dimension);
+			case RandomLieAlgebraType::metric:
+				if (dimension%2) throw std::invalid_argument("metric Lie algebras are generated as cotangent extensions, so the dimension should be even");
+				return metric(dimension);
+		}
+		return {};
+	}
+	//the images of the frame under the flat isomorphism of the ad-invariant metric on a metric Lie algebra of the given dimension
+	static vector<IntegerForm> invariant_metric_flat(int dimension) {
+		int m=dimension/2;
+		vector<IntegerForm> result;
+		for (int i=0;i<dimension;++i) result.push_back({{FormMask{1}<<(i<m? i+m : i-m),1}});
+		return result;
+	}
+};
+
+inline StructureConstants structure_constants(const vector<IntegerForm>& de) {
+	vector<StructureConstantTriple> triples;
+	for (int k=0;k<de.size();++k)
+		for (auto& term : de[k])
+			triples.push_back({lowest_index(term.first)+1,lowest_index(term.first&(term.first-1))+1,k+1,numeric(term.second)});
+	return StructureConstants(de.size(),std::move(triples));
+}
+
+//a comma-separated list of forms in the notation of ParseDifferentialForms, which represents indices up to 51
+inline string to_notation(const vector<IntegerForm>& forms) {
+	auto index_character=[] (int i) -> char {
+		++i;
+		if (i<10) return '0'+i;
+		if (i<36) return 'a'+(i-10);
+		if (i<52) return 'A'+(i-36);
+		throw std::invalid_argument("index too large for the notation of differential forms");
+	};
+	string result;
+	for (int k=0;k<forms.size();++k) {
+		if (k) result+=',';
+		if (forms[k].empty()) result+='0';
+		bool first=true;
+		for (auto& term : forms[k]) {
+			if (term.second<0) result+='-';
+			else if (!first) result+='+';
+			if (abs(term.second)!=1) result+=to_string(abs(term.second))+'*';
+			for (FormMask A=term.first;A;A&=A-1) result+=index_character(lowest_index(A));
+			first=false;
+		}
+	}
+	return result;
+}
+
+}
+#endif
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_STRUCTURE_CONSTANTS_H
+#define RATATOSKR_STRUCTURE_CONSTANTS_H
+namespace ratatoskr {
+using namespace GiNaC;
+using namespace Wedge;
+
+/** @brief A nonzero structure constant, i.e. the coefficient c of e^{ij} in de^k. Indices are 1-based and i<j */
+struct StructureConstantTriple {
+	int i,j,k;
+	ex c;
+};
+
+/** @brief Sparse table of the structure constants of a Lie algebra relative to its frame
+ *
+ * The convention is the same as in the --lie-algebra notation, i.e. de^k=\sum_{i<j} c^k_{ij}e^{ij}; equivalently, [e_i,e_j]=-\sum_k c^k_{ij}e_k.
+ */
+class StructureConstants {
+	int dimension_;
+	vector<StructureConstantTriple> triples_;
+public:
+	StructureConstants(int dimension, vector<StructureConstantTriple> triples={}) : dimension_{dimension}, triples_{std::move(triples)} {}
+	explicit StructureConstants(const LieGroup& G) : dimension_(G.Dimension()) {
+		const auto& e=G.e();
+		for (int k=1;k<=dimension_;++k) {
+			ex dek=G.d(e[k-1]);
+			if (dek.is_zero()) continue;
+			for (int i=1;i<=dimension_;++i) {
+				ex hook_i=Hook(e[i-1],dek);
+				if (hook_i.is_zero()) continue;
+				for (int j=i+1;j<=dimension_;++j) {
+					ex c=Hook(e[j-1],hook_i).expand();
+					if (!c.is_zero()) triples_.push_back({i,j,k,c});
+				}
+			}
+		}
+	}
+	int Dimension() const {return dimension_;}
+	const vector<StructureConstantTriple>& triples() const {return triples_;}
+	//true if all the structure constants are rational numbers
+	bool is_rational() const {
+		return all_of(triples_.begin(),triples_.end(),[] (auto& triple) {return triple.c.info(info_flags::rational);});
+	}
+	//the coefficient of e_k in [e_i,e_j], with 1-based indices
+	ex bracket(int i, int j, int k) const {
+		if (i==j) return 0;
+		int sign=i<j? -1 : 1;
+		if (i>j) swap(i,j);
+		for (auto& triple: triples_)
+			if (triple.i==i && triple.j==j && triple.k==k) return sign*triple.c;
+		return 0;
+	}
+};
+
+/** @brief A Lie group constructed directly from a table of structure constants, without parsing the differentials of its coframe */
+class LieGroupFromStructureConstants : public LieGroupHasParameters<false>, public ConcreteManifold, public virtual Has_dTable {
+public:
+	explicit LieGroupFromStructureConstants(const StructureConstants& c) : ConcreteManifold(c.Dimension()) {
+		exvector de(c.Dimension());
+		for (auto& triple: c.triples())
+			de[triple.k-1]+=triple.c*e()[triple.i-1]*e()[triple.j-1];
+		for (int k=0;k<c.Dimension();++k)
+			Declare_d(e()[k],de[k]);
+	}
+};
+
+}
+#endif
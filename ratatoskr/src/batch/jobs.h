@@ -0,0 +1,72 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_JOBS_H
+#define RATATOSKR_JOBS_H
+#include <fstream>
+namespace ratatoskr {
+
+/** @brief A job in a batch run, given by the command-line arguments that are added to the common ones */
+using Job=vector<string>;
+
+class BatchFileError : public CommandLineError {
+public:
+	BatchFileError(const string& filename) : CommandLineError{"cannot read batch file "+filename} {}
+};
+
+//splits a line into whitespace-separated arguments
+inline Job job_from_line(const string& line) {
+	Job result;
+	stringstream s{line};
+	string argument;
+	while (s>>argument) result.push_back(argument);
+	return result;
+}
+
+//reads one job per line; empty lines and lines starting with # are ignored
+inline vector<Job> read_jobs(istream& is) {
+	vector<Job> result;
+	string line;
+	while (getline(is,line)) {
+		auto job=job_from_line(line);
+		if (!job.empty() && job[0][0]!='#') result.push_back(std::move(job));
+	}
+	return result;
+}
+
+//reads jobs from a file, or from standard input if filename is "-"
+inline vector<Job> read_jobs(const string& filename) {
+	if (filename=="-") return read_jobs(cin);
+	ifstream file{filename};
+	if (!file) throw BatchFileError(filename);
+	return read_jobs(file);
+}
+
+/** @brief Command line for a job, obtained by appending the job's arguments to the common ones
+ *
+ * The returned pointers refer to the strings in argv and job, which must outlive the result.
+ */
+inline vector<const char*> job_command_line(int argc, const char** argv, const Job& job) {
+	vector<const char*> result(argv,argv+argc);
+	for (auto& argument: job) result.push_back(argument.c_str());
+	return result;
+}
+
+}
+#endif
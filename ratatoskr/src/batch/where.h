@@ -0,0 +1,137 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_WHERE_H
+#define RATATOSKR_WHERE_H
+#include <functional>
+#include <optional>
+#include "../algebra/invariants.h"
+#include "../forms/formnotation.h"
+#include "../input/catalog.h"
+namespace ratatoskr {
+
+class PredicateError : public CommandLineError {
+public:
+	PredicateError(const string& error) : CommandLineError{"invalid predicate in --where: "+error} {}
+};
+
+/** @brief A conjunction of conditions on the invariants of a Lie algebra, used to skip jobs in batch runs
+ *
+ * Conditions are separated by commas; each condition is either one of abelian, nilpotent, solvable, unimodular, possibly preceded by !, or
+ * a comparison NAME OP N, where NAME is one of dim, derived, centre, nilpotency-step, derived-length and OP is one of ==, !=, <, <=, >, >=.
+ */
+class InvariantPredicate {
+	using Condition=function<bool(const LieAlgebraInvariants&)>;
+	vector<Condition> conditions;
+	static string trim(const string& s) {
+		auto begin=s.find_first_not_of(" \t"), end=s.find_last_not_of(" \t");
+		return begin==string::npos? string{} : s.substr(begin,end-begin+1);
+	}
+	static Condition boolean_condition(const string& name) {
+		if (name=="abelian") return [] (auto& invariants) {return invariants.abelian();};
+		if (name=="nilpotent") return [] (auto& invariants) {return invariants.nilpotent();};
+		if (name=="solvable") return [] (auto& invariants) {return invariants.solvable();};
+		if (name=="unimodular") return [] (auto& invariants) {return invariants.unimodular;};
+		throw PredicateError("unknown property "+name);
+	}
+	static int LieAlgebraInvariants::* integer_invariant(const string& name) {
+		if (name=="dim") return &LieAlgebraInvariants::dimension;
+		if (name=="derived") return &LieAlgebraInvariants::derived_dimension;
+		if (name=="centre" || name=="center") return &LieAlgebraInvariants::centre_dimension;
+		if (name=="nilpotency-step") return &LieAlgebraInvariants::nilpotency_step;
+		if (name=="derived-length") return &LieAlgebraInvariants::derived_length;
+		throw PredicateError("unknown invariant "+name);
+	}
+	static function<bool(int,int)> comparison(const string& op) {
+		if (op=="==" || op=="=") return equal_to<int>{};
+		if (op=="!=") return not_equal_to<int>{};
+		if (op=="<") return less<int>{};
+		if (op=="<=") return less_equal<int>{};
+		if (op==">") return greater<int>{};
+		if (op==">=") return greater_equal<int>{};
+		throw PredicateError("unknown comparison "+op);
+	}
+	static Condition parse_condition(const string& condition) {
+		auto op_begin=condition.find_first_of("=!<>");
+		if (op_begin==string::npos) return boolean_condition(condition);
+		if (op_begin==0 && condition.size()>1 && condition[1]!='=') {
+			auto negated=boolean_condition(trim(condition.substr(1)));
+			return [negated] (auto& invariants) {return !negated(invariants);};
+		}
+		auto op_end=condition.find_first_not_of("=!<>",op_begin);
+		if (op_end==string::npos) throw PredicateError("missing value in "+condition);
+		auto invariant=integer_invariant(trim(condition.substr(0,op_begin)));
+		auto compare=comparison(condition.substr(op_begin,op_end-op_begin));
+		string value=trim(condition.substr(op_end));
+		size_t parsed=0;
+		int n;
+		try {
+			n=stoi(value,&parsed);
+		}
+		catch (const std::logic_error&) {
+			throw PredicateError("expected an integer in "+condition);
+		}
+		if (parsed!=value.size()) throw PredicateError("expected an integer in "+condition);
+		return [invariant,compare,n] (auto& invariants) {return compare(invariants.*invariant,n);};
+	}
+public:
+	explicit InvariantPredicate(const string& predicate) {
+		stringstream s{predicate};
+		string condition;
+		while (getline(s,condition,',')) {
+			condition=trim(condition);
+			if (condition.empty()) throw PredicateError("empty condition in "+predicate);
+			conditions.push_back(parse_condition(condition));
+		}
+	}
+	bool operator()(const LieAlgebraInvariants& invariants) const {
+		return all_of(conditions.begin(),conditions.end(),[&invariants] (auto& condition) {return condition(invariants);});
+	}
+};
+
+//the value of the last --lie-algebra option on the command line, or the empty string if there is none
+inline string lie_algebra_argument(const vector<const char*>& command_line) {
+	const string option="--lie-algebra";
+	string result;
+	for (int i=0;i<command_line.size();++i) {
+		string argument=command_line[i];
+		if (argument==option && i+1<command_line.size()) result=command_line[++i];
+		else if (argument.compare(0,option.size()+1,option+"=")==0) result=argument.substr(option.size()+1);
+	}
+	return result;
+}
+
+/** @brief Whether a job should run, i.e. the Lie algebra in its command line satisfies the predicate
+ *
+ * Jobs whose Lie algebra cannot be determined, e.g. families depending on parameters, are not skipped, so that the program itself reports any error.
+ */
+inline bool satisfies(const InvariantPredicate& predicate, const vector<const char*>& command_line) {
+	auto lie_algebra=lie_algebra_argument(command_line);
+	if (lie_algebra.empty()) return true;
+	try {
+		auto c=lie_algebra[0]=='@'? structure_constants_from_reference(lie_algebra.substr(1)) : lie_algebra_structure_constants(lie_algebra);
+		return predicate(lie_algebra_invariants(c));
+	}
+	catch (const std::exception&) {
+		return true;
+	}
+}
+
+}
+#endif
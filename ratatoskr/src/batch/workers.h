@@ -0,0 +1,236 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_WORKERS_H
+#define RATATOSKR_WORKERS_H
+#include <unistd.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
+#include <cstdint>
+#include <cerrno>
+#include <thread>
+#include <atomic>
+#include <cstring>
+#include <string_view>
+#include "../output/bufferedoutput.h"
+namespace ratatoskr {
+
+class WorkerError : public std::runtime_error {
+public:
+	using runtime_error::runtime_error;
+};
+
+inline void write_all(int fd, const void* data, size_t size) {
+	auto p=static_cast<const char*>(data);
+	while (size) {
+		auto written=write(fd,p,size);
+		if (written<0 && errno==EINTR) continue;
+		if (written<=0) throw WorkerError("error writing to pipe");
+		p+=written;
+		size-=written;
+	}
+}
+
+//returns false if end of file is reached before reading anything
+inline bool read_all(int fd, void* data, size_t size) {
+	auto p=static_cast<char*>(data);
+	size_t total=0;
+	while (total<size) {
+		auto bytes=read(fd,p+total,size-total);
+		if (bytes<0 && errno==EINTR) continue;
+		if (bytes==0 && total==0) return false;
+		if (bytes<=0) throw WorkerError("error reading from pipe");
+		total+=bytes;
+	}
+	return true;
+}
+
+inline int available_processors() {
+	return max(1u,thread::hardware_concurrency());
+}
+
+//the number of processes that a single job may use for its own computations; it is set to 1 in the workers of run_jobs, which already share the processors
+inline int& job_workers() {
+	static int workers=available_processors();
+	return workers;
+}
+
+struct JobOutputHeader {
+	int32_t job;
+	//nonzero if the output is in the shared ring of the worker rather than following the header in the pipe
+	int32_t shared;
+	uint64_t size;
+};
+
+/** @brief A ring buffer in memory shared between a worker process and the coordinator, carrying the outputs of jobs
+ *
+ * The memory is mapped before forking. The worker copies each output to the ring, if there is room, and sends its JobOutputHeader through the pipe;
+ * the coordinator, which reads outputs in the order they were sent, then finds it at the same position and releases the space by advancing the shared read position.
+ * Outputs are contiguous in the ring: an output that does not fit before the end of the ring starts at the beginning, on both sides.
+ * Outputs for which there is no room are sent through the pipe, so that the worker never waits for the coordinator.
+ */
+class SharedRing {
+	struct Control {
+		atomic<uint64_t> read_position;
+	};
+	void* memory=MAP_FAILED;
+	size_t capacity;
+	//the position of the next output, in the worker for writing and in the coordinator for reading
+	uint64_t position=0;
+	Control* control() const {return static_cast<Control*>(memory);}
+	char* data() const {return static_cast<char*>(memory)+sizeof(Control);}
+	//the position where an output of the given size starts
+	uint64_t start_of(uint64_t size) const {
+		auto offset=position%capacity;
+		return offset+size>capacity? position+capacity-offset : position;
+	}
+public:
+	static constexpr size_t default_capacity=32<<20;
+	explicit SharedRing(size_t capacity) : capacity{capacity} {
+		if (!capacity) return;
+		memory=mmap(nullptr,sizeof(Control)+capacity,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_ANONYMOUS,-1,0);
+		if (memory==MAP_FAILED) throw WorkerError("cannot map shared memory");
+		new (control()) Control{};
+	}
+	SharedRing(SharedRing&& other) : memory{other.memory}, capacity{other.capacity}, position{other.position} {
+		other.memory=MAP_FAILED;
+	}
+	SharedRing(const SharedRing&)=delete;
+	~SharedRing() {
+		if (memory!=MAP_FAILED) munmap(memory,sizeof(Control)+capacity);
+	}
+	//called by the worker; returns false if there is no room for the output, which should then be sent through the pipe
+	bool write(const string& output) {
+		if (memory==MAP_FAILED || output.empty() || output.size()>capacity) return false;
+		auto start=start_of(output.size());
+		if (start+output.size()-control()->read_position.load(memory_order_acquire)>capacity) return false;
+		memcpy(data()+start%capacity,output.data(),output.size());
+		position=start+output.size();
+		return true;
+	}
+	//called by the coordinator for each output sent through the ring, in order; the output is only valid until release() is called
+	string_view read(uint64_t size) {
+		auto start=start_of(size);
+		position=start+size;
+		return {data()+start%capacity,size};
+	}
+	void release() {
+		control()->read_position.store(position,memory_order_release);
+	}
+};
+
+/** @brief Runs the jobs 0,...,number_of_jobs-1 in forked worker processes, writing their output to os in the order of jobs
+ *
+ * Worker w runs the jobs w, w+workers, w+2*workers,..., and sends each output back as soon as it is complete, through a SharedRing of the given capacity
+ * if there is room, or else through a pipe; a zero capacity means that only pipes are used.
+ * The callable run_job should take the index of the job and return its output as a string; it should not throw.
+ */
+template<typename RunJob>
+void run_jobs(int number_of_jobs, int workers, const RunJob& run_job, ostream& os, size_t shared_ring_capacity=SharedRing::default_capacity) {
+	if (workers<=1 || number_of_jobs<=1) {
+		for (int i=0;i<number_of_jobs;++i) {
+			os<<run_job(i);
+			end_of_job(os);
+		}
+		return;
+	}
+	workers=min(workers,number_of_jobs);
+	os.flush(); cout.flush(); cerr.flush();
+	vector<pollfd> pipes;
+	vector<pid_t> pids;
+	vector<SharedRing> rings;
+	for (int w=0;w<workers;++w) rings.emplace_back(shared_ring_capacity);
+	for (int w=0;w<workers;++w) {
+		int fd[2];
+		if (pipe(fd)) throw WorkerError("cannot create pipe");
+		pid_t pid=fork();
+		if (pid<0) throw WorkerError("cannot fork");
+		if (pid==0) {
+			close(fd[0]);
+			job_workers()=1;
+			try {
+				for (int i=w;i<number_of_jobs;i+=workers) {
+					string output=run_job(i);
+					bool shared=rings[w].write(output);
+					JobOutputHeader header{i,shared,output.size()};
+					write_all(fd[1],&header,sizeof(header));
+					if (!shared) write_all(fd[1],output.data(),output.size());
+				}
+			}
+			catch (...) {
+				_exit(1);
+			}
+			close(fd[1]);
+			_exit(0);
+		}
+		close(fd[1]);
+		pids.push_back(pid);
+		pipes.push_back(pollfd{fd[0],POLLIN,0});
+	}
+	map<int,string> pending;
+	int next=0, open_pipes=workers;
+	auto write_pending=[&] () {
+		for (auto i=pending.find(next);i!=pending.end();i=pending.find(++next)) {
+			os<<i->second;
+			end_of_job(os);
+			pending.erase(i);
+		}
+	};
+	while (open_pipes>0) {
+		if (poll(pipes.data(),pipes.size(),-1)<0) {
+			if (errno==EINTR) continue;
+			throw WorkerError("error polling workers");
+		}
+		for (int w=0;w<workers;++w) {
+			auto& worker=pipes[w];
+			if (worker.fd<0 || !worker.revents) continue;
+			JobOutputHeader header;
+			if (!read_all(worker.fd,&header,sizeof(header))) {
+				close(worker.fd);
+				worker.fd=-1;
+				--open_pipes;
+				continue;
+			}
+			if (!header.shared) {
+				string output(header.size,'\0');
+				read_all(worker.fd,output.data(),header.size);
+				pending.emplace(header.job,std::move(output));
+			}
+			else if (header.job==next) {
+				//the output is written directly from shared memory
+				auto output=rings[w].read(header.size);
+				os.write(output.data(),output.size());
+				rings[w].release();
+				end_of_job(os);
+				++next;
+			}
+			else {
+				pending.emplace(header.job,string{rings[w].read(header.size)});
+				rings[w].release();
+			}
+			write_pending();
+		}
+	}
+	for (auto pid: pids) waitpid(pid,nullptr,0);
+	if (next<number_of_jobs) throw WorkerError("worker terminated before completing its jobs");
+}
+
+}
+#endif
@@ -21,6 +21,11 @@
 #define RATATOSKR_CONVERSIONS_H
 #include <wedge/wedge.h>
 #include "errors.h"
+#include "../spinors/sparsespinor.h"
+#include "../input/structureconstantsfile.h"
+#include "../input/catalog.h"
+#include "../algebra/differentialcomplex.h"
+#include "../forms/formnotation.h"
 #include "asunique.h"
 #include "../parameters/dependentparameters.h"
 #include "symbols.h"
@@ -23,10 +23,41 @@ namespace ratatoskr {
 using namespace GiNaC;
 using namespace Wedge;
 
+/** @brief Parses a comma-separated list of forms on the given frame with FormNotationParser, falling back to ParseDifferentialForms if it does not recognize them
+ *
+ * Coefficients in brackets which are not rational numbers are parsed as expressions in the given symbols.
+ */
+inline exvector parse_differential_forms(const exvector& e, const string& forms, const lst& symbols=lst{}) {
+	try {
+		optional<ExpressionParser> expression_parser;
+		FormNotationParser parser{static_cast<int>(e.size()),[&expression_parser,&symbols] (const string& coefficient) {
+			if (!expression_parser) expression_parser.emplace(symbols);
+			return (*expression_parser)(coefficient);
+		}};
+		exvector result;
+		for (auto& form : parser.parse_forms(forms)) result.push_back(form.to_ex(e));
+		return result;
+	}
+	//GiNaC parse errors are invalid_argument exceptions
+	catch (const FormNotationError&) {}
+	catch (const std::invalid_argument&) {}
+	if (symbols.nops()) return ParseDifferentialForms(e,forms.c_str(),symbols);
+	return ParseDifferentialForms(e,forms.c_str());
+}
+
+inline ex parse_differential_form(const exvector& e, const string& form, const lst& symbols=lst{}) {
+	if (form.find(',')==string::npos) {
+		auto forms=parse_differential_forms(e,form,symbols);
+		if (forms.size()==1) return forms[0];
+	}
+	if (symbols.nops()) return ParseDifferentialForm(e,form.c_str(),symbols);
+	return ParseDifferentialForm(e,form.c_str());
+}
+
 template<typename Parameters,  typename GroupType>
 auto differential_form(ex Parameters::*p,unique_ptr<GroupType> Parameters::*G) {
 	auto converter=[] (const string& parameter, unique_ptr<LieGroup>& G) {
-		return ParseDifferentialForm(G->e(),parameter.c_str());
+		return parse_differential_form(G->e(),parameter);
 	};
 	return generic_converter(p,converter,G);
 }
@@ -34,31 +65,49 @@ auto differential_form(ex Parameters::*p,unique_ptr<GroupType> Parameters::*G) {
 template<typename Parameters,  typename GroupType>
 auto differential_form(ex Parameters::*p,unique_ptr<GroupType> Parameters::*G,GlobalSymbols Parameters::*symbols) {
 	auto converter=[] (const string& parameter, unique_ptr<LieGroup>& G, const GlobalSymbols& global_symbols) {
-		return ParseDifferentialForm(G->e(),parameter.c_str(),global_symbols.symbols());
+		return parse_differential_form(G->e(),parameter,global_symbols.symbols());
 	};
 	return generic_converter(p,converter,G,symbols);
 }
 
 inline exvector parse_expressions(const string& comma_separated_ex, const lst& symbols=lst{}) {
-	int n=0;
-	int last_comma;
 	exvector result;
-	do {
-		last_comma=comma_separated_ex.find(',',n);			
-		auto substring=comma_separated_ex.substr(n,last_comma==string::npos? string::npos : last_comma-n);
-		result.emplace_back(substring,symbols);		
-		n=last_comma+1;
-	} while (last_comma!=string::npos);
+	ExpressionParser parser{symbols};
+	for_each_field(comma_separated_ex,',',[&result,&parser] (string_view field) {
+		result.push_back(parser(string{field}));
+	});
 	return result;
 }
 
+/** @brief Parse the components of a spinor relative to the basis u(0),...,u(N-1)
+ *
+ * Either all coefficients are given as a comma-separated list, or only the nonzero ones, as a comma-separated list of elements of the form i:coefficient.
+ */
+inline SparseVector parse_spinor_components(const string& parameter, int dimension, const lst& symbols=lst{}) {
+	SparseVector result;
+	if (parameter.find(':')==string::npos) {
+		auto coefficients=parse_expressions(parameter,symbols);
+		if (coefficients.size()>dimension) throw ConversionError("spinor has "+to_string(coefficients.size())+" coefficients, but the spinor representation has dimension "+to_string(dimension));
+		for (int i=0;i<coefficients.size();++i)
+			if (!coefficients[i].is_zero()) result.emplace(i,coefficients[i]);
+		return result;
+	}
+	ExpressionParser parser{symbols};
+	for_each_field(parameter,',',[&result,dimension,&parser] (string_view field) {
+		auto colon=field.find(':');
+		if (colon==string_view::npos) throw ConversionError("expected index:coefficient in spinor, found "+string{field});
+		int i;
+		if (!parse_value(field.substr(0,colon),i)) throw ConversionError("invalid spinor index in "+string{field});
+		if (i<0 || i>=dimension) throw ConversionError("spinor index "+to_string(i)+" out of range, the spinor representation has dimension "+to_string(dimension));
+		result[i]+=parser(string{field.substr(colon+1)});
+	});
+	return SparseSpinor{result}.Components();
+}
+
 template<typename Parameters>
 auto spinor(ex Parameters::*p,unique_ptr<PseudoRiemannianStructureByOrthonormalFrame> Parameters::*g) {
 	auto converter=[] (const string& parameter,  unique_ptr<PseudoRiemannianStructureByOrthonormalFrame>& g) {
-		auto coefficients=parse_expressions(parameter);
-		ex result;
-		for (int i=0;i<coefficients.size();++i) result+=coefficients[i]*g->u(i);
-		return result;		
+		return SparseSpinor{parse_spinor_components(parameter,g->DimensionOfSpinorRepresentation())}.to_ex(*g);
 	};
 	return generic_converter(p,converter,g);
 }
@@ -66,10 +115,23 @@ auto spinor(ex Parameters::*p,unique_ptr<PseudoRiemannianStructureByOrthonormalF
 template<typename Parameters, typename Symbols>
 auto spinor(ex Parameters::*p,unique_ptr<PseudoRiemannianStructureByOrthonormalFrame> Parameters::*g,Symbols Parameters::*symbols) {
 	auto converter=[] (const string& parameter,  unique_ptr<PseudoRiemannianStructureByOrthonormalFrame>& g,const Symbols& symbols) {
-		auto coefficients=parse_expressions(parameter,symbols.symbols());
-		ex result;
-		for (int i=0;i<coefficients.size();++i) result+=coefficients[i]*g->u(i);
-		return result;		
+		return SparseSpinor{parse_spinor_components(parameter,g->DimensionOfSpinorRepresentation(),symbols.symbols())}.to_ex(*g);
+	};
+	return generic_converter(p,converter,g,symbols);
+}
+
+template<typename Parameters>
+auto spinor(SparseSpinor Parameters::*p,unique_ptr<PseudoRiemannianStructureByOrthonormalFrame> Parameters::*g) {
+	auto converter=[] (const string& parameter,  unique_ptr<PseudoRiemannianStructureByOrthonormalFrame>& g) {
+		return SparseSpinor{parse_spinor_components(parameter,g->DimensionOfSpinorRepresentation())};
+	};
+	return generic_converter(p,converter,g);
+}
+
+template<typename Parameters, typename Symbols>
+auto spinor(SparseSpinor Parameters::*p,unique_ptr<PseudoRiemannianStructureByOrthonormalFrame> Parameters::*g,Symbols Parameters::*symbols) {
+	auto converter=[] (const string& parameter,  unique_ptr<PseudoRiemannianStructureByOrthonormalFrame>& g,const Symbols& symbols) {
+		return SparseSpinor{parse_spinor_components(parameter,g->DimensionOfSpinorRepresentation(),symbols.symbols())};
 	};
 	return generic_converter(p,converter,g,symbols);
 }
@@ -23,17 +23,56 @@ namespace ratatoskr {
 using namespace GiNaC;
 using namespace Wedge;
 
+//a command-line parameter of the form @filename or @catalog:NAME indicates a Lie algebra whose structure constants are read from a file or a catalog
+inline bool is_file_reference(const string& parameter) {
+	return !parameter.empty() && parameter[0]=='@';
+}
+
+//rejects structure constants that do not satisfy the Jacobi identity, before any computation takes place
+inline void check_jacobi_identity(const StructureConstants& c, const string& parameter) {
+	if (auto k=jacobi_violation(c)) throw ConversionError(parameter+" is not a Lie algebra, since d(de^"+to_string(k)+") is not zero");
+}
+
+template<typename LieGroupType>
+unique_ptr<LieGroupType> checked_lie_algebra(unique_ptr<LieGroupType> G, const string& parameter) {
+	check_jacobi_identity(StructureConstants{*G},parameter);
+	return G;
+}
+
+template<typename ParameterType>
+unique_ptr<ParameterType> lie_algebra_from_file(const string& reference) {
+	if constexpr (is_convertible_v<LieGroupFromStructureConstants*,ParameterType*>) {
+		StructureConstants c{0};
+		try {
+			c=structure_constants_from_reference(reference);
+		}
+		catch (const InputFileError& error) {
+			throw ConversionError(error.what());
+		}
+		check_jacobi_identity(c,"@"+reference);
+		return make_unique<LieGroupFromStructureConstants>(c);
+	}
+	else throw ConversionError("a Lie algebra read from "+reference+" cannot be used as a parameter of this type");
+}
+
 template<typename Parameters, typename ParameterType>
 auto lie_algebra(unique_ptr<ParameterType> Parameters::*p) {
-	auto converter=[] (const string& parameter) {
-		return make_unique<AbstractLieGroup<false>>(parameter);
+	auto converter=[] (const string& parameter) -> unique_ptr<ParameterType> {
+		if (is_file_reference(parameter)) return lie_algebra_from_file<ParameterType>(parameter.substr(1));
+		//rational structure constants are checked as parsed, without computing them from the Lie algebra built by Wedge
+		if (auto c=structure_constants_from_notation(parameter)) {
+			check_jacobi_identity(*c,parameter);
+			return make_unique<AbstractLieGroup<false>>(parameter);
+		}
+		return checked_lie_algebra(make_unique<AbstractLieGroup<false>>(parameter),parameter);
 	};
 	return generic_converter(p,converter);
 }
 template<typename Parameters, typename ParameterType, typename SymbolsClass>
 auto lie_algebra(unique_ptr<ParameterType> Parameters::*p, SymbolsClass Parameters::*symbols) {
-	auto converter=[] (const string& parameter, const Symbols& symbols) {
-		return make_unique<LieGroupFamily>(parameter,symbols.symbols());
+	auto converter=[] (const string& parameter, const Symbols& symbols) -> unique_ptr<ParameterType> {
+		if (is_file_reference(parameter)) return lie_algebra_from_file<ParameterType>(parameter.substr(1));
+		return checked_lie_algebra(make_unique<LieGroupFamily>(parameter,symbols.symbols()),parameter);
 	};
 	return generic_converter(p,converter,symbols);
 }
@@ -51,7 +90,7 @@ make_subgroup(const LieGroupHasParameters<false>& G, const exvector& subalgebra)
 template<typename Parameters, typename LieSubgroupType, typename LieGroupType>
 auto lie_subalgebra(unique_ptr<LieSubgroupType> Parameters::*p, unique_ptr<LieGroupType> Parameters::*G) {
 	auto converter=[] (const string& parameter, const unique_ptr<LieGroupType>& G) {
-		return make_subgroup(*G,ParseDifferentialForms(G->e(),parameter.c_str()));
+		return make_subgroup(*G,parse_differential_forms(G->e(),parameter));
 	};
 	return generic_converter(p,converter,G);
 }
@@ -59,7 +98,7 @@ auto lie_subalgebra(unique_ptr<LieSubgroupType> Parameters::*p, unique_ptr<LieGr
 template<typename Parameters, typename LieSubgroupType, typename LieGroupType, typename SymbolsClass>
 auto lie_subalgebra(unique_ptr<LieSubgroupType> Parameters::*p, unique_ptr<LieGroupType> Parameters::*G, SymbolsClass Parameters::*symbols) {
 	auto converter=[] (const string& parameter, const unique_ptr<LieGroupType>& G, const Symbols& symbols) {
-		return make_unique<AbstractLieSubgroup<true>>(*G,ParseDifferentialForms(G->e(),parameter.c_str(),symbols.symbols()));
+		return make_unique<AbstractLieSubgroup<true>>(*G,parse_differential_forms(G->e(),parameter,symbols.symbols()));
 	};
 	return generic_converter(p,converter,G,symbols);
 }
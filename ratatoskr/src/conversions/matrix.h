@@ -41,9 +41,22 @@ inline matrix matrix_from_string_matrix(const vector<vector<string>>&m, const Sy
 }
 
 inline matrix matrix_from_rows(const vector<string>& s, const Symbols& symbols) {
-    vector<vector<string>> elements;
-    std::transform(s.begin(),s.end(),std::back_inserter(elements),[] (auto& string) {return splice(string);});
-    return matrix_from_string_matrix(elements,symbols.symbols());
+    if (s.empty()) return matrix{};
+    matrix result(s.size(),splice_view(s[0]).size());
+    for (int i=0;i<result.rows();++i) {
+        int j=0;
+        for_each_field(s[i],',',[&] (string_view entry) {
+            if (j>=result.cols()) throw UnevenMatrix(result.rows(),result.cols());
+            try  {
+                result(i,j++)=symbols.ex_from_string(string{entry});
+            }
+            catch (...) {
+                throw ParseError(string{entry});
+            }
+        });
+        if (j!=result.cols()) throw UnevenMatrix(result.rows(),result.cols());
+    }
+    return result;
 }
 inline matrix diagonal_matrix_from_strings(const vector<string>& s, const Symbols& symbols) {
 	unsigned int order=static_cast<int>(s.size());
@@ -27,7 +27,7 @@ template<typename Parameters, typename ParameterType, typename GroupType>
 auto metric_by_on_coframe(unique_ptr<ParameterType> Parameters::*p,unique_ptr<GroupType> Parameters::*G,pair<int,int> Parameters::*signature,CliffordConvention clifford_convention=CliffordConvention::STANDARD) {
 	auto converter=[clifford_convention] (const string& parameter, unique_ptr<LieGroup>& G, pair<int,int> signature) {
 		if (signature.first<0 || signature.second<0 || signature.first+signature.second!=G->Dimension()) throw ConversionError("signature should be a pair of nonnegative integers summing to the dimension");
-		auto on_coframe=ParseDifferentialForms(G->e(),parameter.c_str());
+		auto on_coframe=parse_differential_forms(G->e(),parameter);
 		return as_unique(PseudoRiemannianStructureByOrthonormalFrame::FromSignature(G.get(),on_coframe, signature,clifford_convention));
 	};
 	return generic_converter(p,converter,G,signature);
@@ -36,7 +36,7 @@ template<typename Parameters, typename ParameterType, typename GroupType>
 auto metric_by_on_frame(unique_ptr<ParameterType> Parameters::*p,unique_ptr<GroupType> Parameters::*G,pair<int,int> Parameters::*signature,CliffordConvention clifford_convention=CliffordConvention::STANDARD) {
 	auto converter=[clifford_convention] (const string& parameter, unique_ptr<LieGroup>& G, pair<int,int> signature) {
 		if (signature.first<0 || signature.second<0 || signature.first+signature.second!=G->Dimension()) throw ConversionError("signature should be a pair of nonnegative integers summing to the dimension");
-		Frame on_coframe=ParseDifferentialForms(G->e(),parameter.c_str());		
+		Frame on_coframe=parse_differential_forms(G->e(),parameter);		
 		return as_unique(PseudoRiemannianStructureByOrthonormalFrame::FromSignature(G.get(),on_coframe.dual(), signature,clifford_convention));
 	};
 	return generic_converter(p,converter,G,signature);
@@ -45,7 +45,7 @@ auto metric_by_on_frame(unique_ptr<ParameterType> Parameters::*p,unique_ptr<Grou
 template<typename Parameters, typename ParameterType, typename GroupType>
 auto metric_by_on_coframe(unique_ptr<ParameterType> Parameters::*p,unique_ptr<GroupType> Parameters::*G,vector<int> Parameters::*timelike_indices,CliffordConvention clifford_convention=CliffordConvention::STANDARD) {	
 	auto converter=[clifford_convention] (const string& parameter, unique_ptr<LieGroup>& G, const vector<int>& timelike_indices) {
-		auto on_coframe=ParseDifferentialForms(G->e(),parameter.c_str());
+		auto on_coframe=parse_differential_forms(G->e(),parameter);
 		return as_unique(PseudoRiemannianStructureByOrthonormalFrame::FromTimelikeIndices(G.get(),on_coframe, timelike_indices,CliffordConvention::STANDARD));
 	};
 	return generic_converter(p,converter,G,timelike_indices);
@@ -53,7 +53,7 @@ auto metric_by_on_coframe(unique_ptr<ParameterType> Parameters::*p,unique_ptr<Gr
 template<typename Parameters, typename ParameterType, typename GroupType>
 auto metric_by_on_frame(unique_ptr<ParameterType> Parameters::*p,unique_ptr<GroupType> Parameters::*G,vector<int> Parameters::*timelike_indices,CliffordConvention clifford_convention=CliffordConvention::STANDARD) {
 	auto converter=[clifford_convention] (const string& parameter, unique_ptr<LieGroup>& G, const vector<int>& timelike_indices) {
-		Frame on_coframe=ParseDifferentialForms(G->e(),parameter.c_str());
+		Frame on_coframe=parse_differential_forms(G->e(),parameter);
 		return as_unique(PseudoRiemannianStructureByOrthonormalFrame::FromTimelikeIndices(G.get(),on_coframe.dual(), timelike_indices,CliffordConvention::STANDARD));
 	};
 	return generic_converter(p,converter,G,timelike_indices);
@@ -71,7 +71,7 @@ matrix metric_from_eflats(const LieGroup& G, const exvector& deflat) {
 template<typename Parameters, typename ParameterType, typename GroupType>
 auto metric_by_flat(unique_ptr<ParameterType> Parameters::*p,unique_ptr<GroupType> Parameters::*G) {
 	auto converter=[] (const string& parameter, unique_ptr<LieGroup>& G) {
-		auto deflat=ParseDifferentialForms(G->e(),parameter.c_str());
+		auto deflat=parse_differential_forms(G->e(),parameter);
 		return as_unique(PseudoRiemannianStructureByMatrix::FromMatrixOnFrame(G.get(),G->e(),metric_from_eflats(*G,deflat)));
 	};
 	return generic_converter(p,converter,G);
@@ -79,7 +79,7 @@ auto metric_by_flat(unique_ptr<ParameterType> Parameters::*p,unique_ptr<GroupTyp
 template<typename Parameters, typename ParameterType, typename GroupType, typename Symbols>
 auto metric_by_flat(unique_ptr<ParameterType> Parameters::*p,unique_ptr<GroupType> Parameters::*G, Symbols Parameters::*symbols) {
 	auto converter=[] (const string& parameter, unique_ptr<LieGroup>& G, const Symbols& symbols) {
-		auto deflat=ParseDifferentialForms(G->e(),parameter.c_str(),symbols.symbols());
+		auto deflat=parse_differential_forms(G->e(),parameter,symbols.symbols());
 		return as_unique(PseudoRiemannianStructureByMatrix::FromMatrixOnFrame(G.get(),G->e(),metric_from_eflats(*G,deflat)));
 	};
 	return generic_converter(p,converter,G,symbols);
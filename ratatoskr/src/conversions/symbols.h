@@ -19,6 +19,7 @@
  *******************************************************************************/
 #ifndef GLOBAL_SYMBOLS_H
 #define GLOBAL_SYMBOLS_H
+#include <unordered_map>
 namespace ratatoskr {
 using namespace Wedge;
 
@@ -30,9 +31,31 @@ lst make_symbols(Name&&... name) {
 	return lst{Parameter{std::forward<Name>(name)}...};
 }
 
+//the table of the given symbols by name, as used by GiNaC::parser
+inline symtab symbol_table(const lst& symbols) {
+	symtab result;
+	for (auto& x: symbols) {
+		if (!is_a<symbol>(x)) throw invalid_argument("symbol table should only contain symbols");
+		result[ex_to<symbol>(x).get_name()]=x;
+	}
+	return result;
+}
+
+/** @brief A parser for expressions in a fixed list of symbols
+ *
+ * Constructing ex{s,symbols} builds a parser and its symbol table for each expression; this object builds them once, so that it can be reused across the entries of a matrix
+ * or a list. As in ex{s,symbols}, names which do not belong to the symbols are an error.
+ */
+class ExpressionParser {
+	parser reader;
+public:
+	explicit ExpressionParser(const lst& symbols) : reader{symbol_table(symbols),true} {}
+	ex operator()(const string& s) {return reader(s);}
+};
+
 struct GlobalSymbols {
-	lst symbols() const {
-		static lst symbols=make_symbols(
+	const lst& symbols() const {
+		static const lst symbols=make_symbols(
 			N.a,N.b,N.c,N.d,N.e,N.f,N.g,N.h,N.i,N.j,N.k,N.l,N.m,N.n,N.o,N.p,N.q,N.r,N.s,N.t,N.u,N.v,N.w,N.x,N.y,N.z,
 			N.A,N.B,N.C,N.D,N.E,N.F,N.G,N.H,N.I,N.J,N.K,N.L,N.M,N.N,N.O,N.P,N.Q,N.R,N.S,N.T,N.U,N.V,N.W,N.X,N.Y,N.Z,
 			N.alpha,N.beta,N.gamma,N.Gamma,N. delta,N.Delta,N.epsilon,N.zeta,N.eta,N.theta,N.Theta,N.kappa,N.lambda,N.Lambda,
@@ -40,10 +63,20 @@ struct GlobalSymbols {
 		);
 		return symbols;
 	}
-	ex by_name(const string& s) {
-		for (auto x: symbols())
-			if (ex_to<Parameter>(x).get_name()==s) return x;
-		throw NoSymbolWithName(s);
+	ex by_name(const string& s) const {
+		static const auto by_name=[this] {
+			unordered_map<string,ex> result;
+			for (auto& x: symbols()) result.emplace(ex_to<Parameter>(x).get_name(),x);
+			return result;
+		}();
+		auto i=by_name.find(s);
+		if (i==by_name.end()) throw NoSymbolWithName(s);
+		return i->second;
+	}
+	//a parser for the global symbols, shared by all the Symbols objects constructed from them
+	shared_ptr<ExpressionParser> shared_parser() const {
+		static const auto parser=make_shared<ExpressionParser>(symbols());
+		return parser;
 	}
 };
 
@@ -64,18 +97,21 @@ public:
 
 class Symbols {
 	lst symbols_;
+	//built on first use and shared by copies
+	mutable shared_ptr<ExpressionParser> parser_;
 public:
 	Symbols() = default;
-	Symbols(const GlobalSymbols& symbols) : symbols_(symbols.symbols()) {}
+	Symbols(const GlobalSymbols& symbols) : symbols_(symbols.symbols()), parser_{symbols.shared_parser()} {}
 	Symbols(const lst& symbols) : symbols_(symbols) {}
 	template<class SymbolClass>
 	Symbols(const Symbol<SymbolClass>& symbol) : symbols_(symbol.symbols()) {}
-	lst symbols() const {
+	const lst& symbols() const {
 		return symbols_;
 	}
 	ex ex_from_string(const string& s) const {
 		try {
-			return ex{s,symbols_};
+			if (!parser_) parser_=make_shared<ExpressionParser>(symbols_);
+			return (*parser_)(s);
 		}
 		catch (...) {
 			cerr<<s<<endl;
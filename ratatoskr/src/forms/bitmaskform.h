@@ -0,0 +1,152 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_BITMASK_FORM_H
+#define RATATOSKR_BITMASK_FORM_H
+#include <cstdint>
+namespace ratatoskr {
+using namespace GiNaC;
+using namespace Wedge;
+
+/** @brief A subset of {0,...,63}, representing the form e^{i_1}\wedge\dots\wedge e^{i_p} with i_1<\dots<i_p */
+using FormMask=uint64_t;
+
+inline int popcount(FormMask A) {return __builtin_popcountll(A);}
+inline int lowest_index(FormMask A) {return __builtin_ctzll(A);}
+
+//the sign \epsilon such that e^A\wedge e^B=\epsilon e^{A\cup B}, for disjoint A and B
+inline int wedge_sign(FormMask A, FormMask B) {
+	int transpositions=0;
+	for (;B;B&=B-1) {
+		FormMask lowest=B&(~B+1);
+		transpositions+=popcount(A&~(lowest|(lowest-1)));
+	}
+	return transpositions%2? -1 : 1;
+}
+
+/** @brief A differential form represented by its nonzero components relative to the basis e^A, A ranging among bitmasks
+ *
+ * Wedge products only involve bit operations and popcounts; GiNaC is only used for the coefficients.
+ */
+class BitmaskForm {
+	map<FormMask,ex> components;
+public:
+	BitmaskForm()=default;
+	BitmaskForm(FormMask A, const ex& coefficient=1) {add(A,coefficient);}
+	const map<FormMask,ex>& Components() const {return components;}
+	bool is_zero() const {return components.empty();}
+	void add(FormMask A, const ex& coefficient) {
+		auto& c=components[A];
+		c=(c+coefficient).expand();
+		if (c.is_zero()) components.erase(A);
+	}
+	BitmaskForm& add(const BitmaskForm& form, const ex& coefficient=1) {
+		for (auto& component : form.components) add(component.first,coefficient*component.second);
+		return *this;
+	}
+	BitmaskForm wedge(const BitmaskForm& form) const {
+		BitmaskForm result;
+		for (auto& x : components)
+		for (auto& y : form.components)
+			if (!(x.first&y.first)) result.add(x.first|y.first,wedge_sign(x.first,y.first)*x.second*y.second);
+		return result;
+	}
+	BitmaskForm& normalize() {
+		for (auto i=components.begin();i!=components.end();)
+			if ((i->second=i->second.normal()).is_zero()) i=components.erase(i);
+			else ++i;
+		return *this;
+	}
+	//the form as a GiNaC expression, where the bit i corresponds to one_forms[i]
+	ex to_ex(const exvector& one_forms) const {
+		ex result;
+		for (auto& component : components) {
+			ex form=1;
+			for (FormMask A=component.first;A;A&=A-1) form*=one_forms[lowest_index(A)];
+			result+=component.second*form;
+		}
+		return result;
+	}
+	/** @brief Converts a form given as a GiNaC expression, where the one-forms are indexed by index_of_basis
+	 *
+	 * Each term of the expanded form should be a product of a coefficient and one-forms appearing in one_forms, possibly grouped in a noncommutative product.
+	 */
+	static BitmaskForm from_ex(const ex& form, const map<ex,int,ex_is_less>& one_forms) {
+		if (one_forms.size()>64) throw std::invalid_argument("BitmaskForm: dimension greater than 64");
+		BitmaskForm result;
+		auto add_term=[&result,&one_forms] (const ex& term) {
+			ex coefficient=1;
+			FormMask A=0;
+			auto add_one_form=[&coefficient,&A,&one_forms] (const ex& x) {
+				auto i=one_forms.find(x);
+				if (i==one_forms.end()) return false;
+				FormMask bit=FormMask{1}<<i->second;
+				if (A&bit) coefficient=0;
+				else {
+					coefficient*=wedge_sign(A,bit);
+					A|=bit;
+				}
+				return true;
+			};
+			auto add_factor=[&coefficient,&add_one_form] (const ex& factor) {
+				if (add_one_form(factor)) return;
+				if (is_a<ncmul>(factor)) {
+					for (auto& x : factor)
+						if (!add_one_form(x)) throw std::invalid_argument("BitmaskForm: "+to_canonical_string(factor)+" is not a product of one-forms");
+				}
+				else coefficient*=factor;
+			};
+			if (is_a<mul>(term))
+				for (auto& factor : term) add_factor(factor);
+			else add_factor(term);
+			result.add(A,coefficient);
+		};
+		ex expanded=form.expand();
+		if (is_a<add>(expanded))
+			for (auto& term : expanded) add_term(term);
+		else if (!expanded.is_zero()) add_term(expanded);
+		return result;
+	}
+};
+
+/** @brief Extends a map defined on one-forms to a derivation of the exterior algebra, or an antiderivation if odd is true
+ *
+ * The image of e^k is images[k]; for instance, the exterior derivative is the antiderivation extending e^k\mapsto de^k.
+ */
+inline BitmaskForm extend_to_derivation(const BitmaskForm& form, const vector<BitmaskForm>& images, bool odd) {
+	BitmaskForm result;
+	for (auto& component : form.Components()) {
+		FormMask A=component.first;
+		int position=0;
+		for (FormMask rest=A;rest;rest&=rest-1,++position) {
+			FormMask bit=rest&(~rest+1);
+			FormMask below=A&(bit-1), above=A&~(bit|(bit-1));
+			int sign=odd && position%2? -1 : 1;
+			for (auto& image : images[lowest_index(bit)].Components()) {
+				FormMask B=image.first;
+				if (B&(below|above)) continue;
+				result.add(below|B|above,sign*wedge_sign(below,B)*wedge_sign(below|B,above)*component.second*image.second);
+			}
+		}
+	}
+	return result;
+}
+
+}
+#endif
@@ -0,0 +1,221 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_FORM_NOTATION_H
+#define RATATOSKR_FORM_NOTATION_H
+#include <functional>
+#include <string_view>
+#include <optional>
+#include "bitmaskform.h"
+#include "../algebra/structureconstants.h"
+namespace ratatoskr {
+using namespace GiNaC;
+
+class FormNotationError : public std::runtime_error {
+public:
+	FormNotationError(string_view s, size_t position, const string& error) :
+		std::runtime_error{"error parsing "+string{s}+" at position "+to_string(position)+": "+error} {}
+};
+
+/** @brief A recursive-descent parser for differential forms in the notation of ParseDifferentialForms, producing BitmaskForm objects
+ *
+ * The grammar is
+ *
+ *	forms := form (',' form)*
+ *	form := ['+'|'-'] term (('+'|'-') term)*
+ *	term := [coefficient '*'] product
+ *	coefficient := integer | integer '/' integer | '[' expression ']' | '(' expression ')'
+ *	product := '0' | (indices | '(' form ')')+
+ *
+ * where the indices 1,...,9,a,...,z,A,...,P stand for e^1,...,e^51, and juxtaposition denotes the wedge product, e.g. 8(9+a) is e^8\wedge(e^9+e^{10}).
+ * Rational coefficients are converted directly; only the other coefficients are handed to parse_coefficient.
+ */
+class FormNotationParser {
+	int dimension;
+	function<ex(const string&)> parse_coefficient;
+	string_view s;
+	size_t position;
+	[[noreturn]] void error(const string& message) const {
+		throw FormNotationError(s,position,message);
+	}
+	bool at(char c) const {return position<s.size() && s[position]==c;}
+	bool at_digit() const {return position<s.size() && isdigit(static_cast<unsigned char>(s[position]));}
+	bool at_index() const {return position<s.size() && isalnum(static_cast<unsigned char>(s[position]));}
+	void expect(char c) {
+		if (!at(c)) error(string{"expected "}+c);
+		++position;
+	}
+	static int index_of(char c) {
+		if (c>='1' && c<='9') return c-'1';
+		if (c>='a' && c<='z') return c-'a'+9;
+		if (c>='A' && c<='P') return c-'A'+35;
+		return -1;
+	}
+	static bool is_integer(string_view x) {
+		if (!x.empty() && x[0]=='-') x.remove_prefix(1);
+		return !x.empty() && all_of(x.begin(),x.end(),[] (char c) {return isdigit(static_cast<unsigned char>(c));});
+	}
+	//a rational number n or n/m, or else the expression parsed by parse_coefficient
+	ex coefficient(string_view x) {
+		auto slash=x.find('/');
+		if (slash==string_view::npos && is_integer(x)) return numeric{string{x}.c_str()};
+		if (slash!=string_view::npos && is_integer(x.substr(0,slash)) && is_integer(x.substr(slash+1))) {
+			numeric denominator{string{x.substr(slash+1)}.c_str()};
+			if (!denominator.is_zero()) return numeric{string{x.substr(0,slash)}.c_str()}/denominator;
+		}
+		return parse_coefficient(string{x});
+	}
+	//the position after the bracket matching the one at the current position
+	size_t matching(char open, char close) const {
+		int depth=0;
+		for (auto i=position;i<s.size();++i)
+			if (s[i]==open) ++depth;
+			else if (s[i]==close && !--depth) return i+1;
+		error(string{"unbalanced "}+open);
+	}
+	//parses a coefficient followed by '*', if there is one at the current position
+	optional<ex> coefficient() {
+		auto begin=position;
+		size_t end;
+		if (at('[') || at('(')) end=matching(s[position],at('[')? ']' : ')');
+		else {
+			end=position;
+			while (end<s.size() && isdigit(static_cast<unsigned char>(s[end]))) ++end;
+			if (end>position && end<s.size() && s[end]=='/') {
+				++end;
+				while (end<s.size() && isdigit(static_cast<unsigned char>(s[end]))) ++end;
+			}
+		}
+		if (end==begin || end>=s.size() || s[end]!='*') return nullopt;
+		position=end+1;
+		return coefficient(s.substr(begin+(s[begin]=='['),end-begin-(s[begin]=='[')*2));
+	}
+	BitmaskForm indices() {
+		FormMask A=0;
+		int sign=1;
+		bool zero=false;
+		for (;at_index();++position) {
+			int i=index_of(s[position]);
+			if (i<0) error(string{"invalid index "}+s[position]);
+			if (i>=dimension) error(string{"index "}+s[position]+" exceeds the dimension "+to_string(dimension));
+			FormMask bit=FormMask{1}<<i;
+			if (A&bit) zero=true;
+			else {
+				sign*=wedge_sign(A,bit);
+				A|=bit;
+			}
+		}
+		return zero? BitmaskForm{} : BitmaskForm{A,sign};
+	}
+	BitmaskForm product() {
+		if (at('0')) {
+			++position;
+			if (at_index() || at('(')) error("unexpected 0");
+			return BitmaskForm{};
+		}
+		if (!at_index() && !at('(')) error("expected a form");
+		BitmaskForm result{0};
+		while (at_index() || at('(')) {
+			if (at('(')) {
+				++position;
+				result=result.wedge(form());
+				expect(')');
+			}
+			else result=result.wedge(indices());
+		}
+		return result;
+	}
+	BitmaskForm term() {
+		auto c=coefficient();
+		auto result=product();
+		if (c) {
+			BitmaskForm scaled;
+			return scaled.add(result,*c);
+		}
+		return result;
+	}
+	BitmaskForm form() {
+		BitmaskForm result;
+		int sign=1;
+		if (at('+') || at('-')) sign=s[position++]=='-'? -1 : 1;
+		result.add(term(),sign);
+		while (at('+') || at('-')) {
+			sign=s[position++]=='-'? -1 : 1;
+			result.add(term(),sign);
+		}
+		return result;
+	}
+public:
+	//a parser for forms on a space of the given dimension, where the coefficients which are not rational numbers are parsed by parse_coefficient
+	FormNotationParser(int dimension, function<ex(const string&)> parse_coefficient) : dimension{dimension}, parse_coefficient{std::move(parse_coefficient)} {
+		if (dimension>51) throw std::invalid_argument("the notation of differential forms represents indices up to 51");
+	}
+	BitmaskForm parse_form(string_view form) {
+		s=form;
+		position=0;
+		auto result=this->form();
+		if (position<s.size()) error("unexpected character");
+		return result;
+	}
+	vector<BitmaskForm> parse_forms(string_view forms) {
+		vector<BitmaskForm> result;
+		s=forms;
+		position=0;
+		while (true) {
+			result.push_back(form());
+			if (position==s.size()) return result;
+			expect(',');
+		}
+	}
+};
+
+/** @brief The structure constants of a Lie algebra written in the notation of --lie-algebra, as a comma-separated list of the de^k
+ *
+ * Returns nothing if FormNotationParser does not recognize the notation, or if it involves coefficients which are not rational numbers or forms which are not 2-forms.
+ */
+inline optional<StructureConstants> structure_constants_from_notation(string_view notation) {
+	vector<BitmaskForm> de;
+	try {
+		FormNotationParser parser{51,[notation] (const string& coefficient) -> ex {
+			throw FormNotationError(notation,0,coefficient+" is not a rational number");
+		}};
+		de=parser.parse_forms(notation);
+	}
+	catch (const FormNotationError&) {
+		return nullopt;
+	}
+	if (de.size()>51) return nullopt;
+	vector<StructureConstantTriple> triples;
+	for (int k=0;k<de.size();++k)
+	for (auto& component : de[k].Components()) {
+		FormMask A=component.first;
+		if (popcount(A)!=2 || A>=(FormMask{1}<<de.size()) || !component.second.info(info_flags::rational)) return nullopt;
+		triples.push_back({lowest_index(A)+1,lowest_index(A&(A-1))+1,k+1,component.second});
+	}
+	return StructureConstants{static_cast<int>(de.size()),std::move(triples)};
+}
+
+//the structure constants of a Lie algebra without parameters written in the notation of --lie-algebra, which is handed to Wedge if structure_constants_from_notation fails
+inline StructureConstants lie_algebra_structure_constants(const string& notation) {
+	if (auto c=structure_constants_from_notation(notation)) return std::move(*c);
+	return StructureConstants{AbstractLieGroup<false>{notation}};
+}
+
+}
+#endif
@@ -0,0 +1,144 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_CATALOG_H
+#define RATATOSKR_CATALOG_H
+#include <cstdlib>
+#include "structureconstantsfile.h"
+namespace ratatoskr {
+using namespace GiNaC;
+
+/** @brief A memory-mapped collection of named Lie algebras
+ *
+ * Layout: the eight characters RTSKCAT1 and the number of entries as int64, followed by an index with four int64 for each entry
+ * (offset and length of the name, offset and length of the data), sorted by name. Offsets are relative to the beginning of the file;
+ * the data of each entry are the structure constants in the binary layout of structureconstantsfile.h.
+ */
+class Catalog {
+	struct IndexEntry {
+		int64_t name_offset, name_length, data_offset, data_length;
+	};
+	static constexpr char magic[]="RTSKCAT1";
+	static constexpr size_t magic_size=sizeof(magic)-1;
+	static constexpr size_t header_size=magic_size+sizeof(int64_t);
+	MappedFile file;
+	size_t entries=0;
+	IndexEntry index_entry(size_t i) const {
+		IndexEntry entry;
+		memcpy(&entry,file.contents().data()+header_size+i*sizeof(IndexEntry),sizeof(IndexEntry));
+		return entry;
+	}
+	string_view slice(int64_t offset, int64_t length) const {
+		auto contents=file.contents();
+		if (offset<0 || length<0 || offset+length>contents.size()) throw InputFileError("corrupted catalog");
+		return contents.substr(offset,length);
+	}
+public:
+	explicit Catalog(const string& filename) : file{filename} {
+		auto contents=file.contents();
+		if (contents.size()<header_size || contents.substr(0,magic_size)!=string_view{magic,magic_size}) throw InputFileError(filename+" is not a catalog");
+		int64_t n;
+		memcpy(&n,contents.data()+magic_size,sizeof(n));
+		if (n<0 || header_size+n*sizeof(IndexEntry)>contents.size()) throw InputFileError(filename+": corrupted catalog index");
+		entries=n;
+	}
+	size_t size() const {return entries;}
+	string_view name(size_t i) const {
+		auto entry=index_entry(i);
+		return slice(entry.name_offset,entry.name_length);
+	}
+	StructureConstants structure_constants(size_t i) const {
+		auto entry=index_entry(i);
+		return parse_structure_constants_binary(slice(entry.data_offset,entry.data_length));
+	}
+	//the position of the entry with the given name, or size() if there is none
+	size_t find(string_view entry_name) const {
+		size_t low=0, high=entries;
+		while (low<high) {
+			size_t middle=(low+high)/2;
+			if (name(middle)<entry_name) low=middle+1;
+			else high=middle;
+		}
+		return low<entries && name(low)==entry_name? low : entries;
+	}
+	StructureConstants structure_constants(string_view entry_name) const {
+		auto i=find(entry_name);
+		if (i==entries) throw InputFileError("no Lie algebra named "+string{entry_name}+" in catalog");
+		return structure_constants(i);
+	}
+	//writes a catalog containing the given entries; names should be distinct
+	static void write(ostream& os, vector<pair<string,StructureConstants>> algebras) {
+		sort(algebras.begin(),algebras.end(),[] (auto& x, auto& y) {return x.first<y.first;});
+		for (int i=1;i<algebras.size();++i)
+			if (algebras[i].first==algebras[i-1].first) throw std::invalid_argument("repeated name "+algebras[i].first+" in catalog");
+		vector<string> data;
+		for (auto& algebra: algebras) {
+			stringstream s;
+			write_structure_constants_binary(s,algebra.second);
+			data.push_back(s.str());
+		}
+		auto write_int64=[&os] (int64_t x) {os.write(reinterpret_cast<const char*>(&x),sizeof(x));};
+		os.write(magic,magic_size);
+		write_int64(algebras.size());
+		int64_t offset=header_size+algebras.size()*sizeof(IndexEntry);
+		for (int i=0;i<algebras.size();++i) {
+			write_int64(offset);
+			write_int64(algebras[i].first.size());
+			offset+=algebras[i].first.size();
+			write_int64(offset);
+			write_int64(data[i].size());
+			offset+=data[i].size();
+		}
+		for (int i=0;i<algebras.size();++i) os<<algebras[i].first<<data[i];
+	}
+};
+
+/** @brief The catalog used to resolve references of the form @catalog:NAME
+ *
+ * It is the file set by the global option --catalog, or otherwise by the environment variable RATATOSKR_CATALOG; it is mapped once and shared by all jobs.
+ */
+inline unique_ptr<Catalog>& catalog_instance() {
+	static unique_ptr<Catalog> catalog;
+	return catalog;
+}
+
+inline void open_catalog(const string& filename) {
+	catalog_instance()=make_unique<Catalog>(filename);
+}
+
+inline const Catalog& default_catalog() {
+	auto& catalog=catalog_instance();
+	if (!catalog) {
+		auto filename=getenv("RATATOSKR_CATALOG");
+		if (!filename) throw InputFileError("no catalog specified; use --catalog or set RATATOSKR_CATALOG");
+		open_catalog(filename);
+	}
+	return *catalog;
+}
+
+//structure constants referred to by NAME or catalog:NAME, i.e. read from a file or from the default catalog
+inline StructureConstants structure_constants_from_reference(const string& reference) {
+	const string catalog_prefix="catalog:";
+	if (reference.compare(0,catalog_prefix.size(),catalog_prefix)==0)
+		return default_catalog().structure_constants(reference.substr(catalog_prefix.size()));
+	return read_structure_constants(reference);
+}
+
+}
+#endif
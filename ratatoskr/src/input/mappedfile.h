@@ -0,0 +1,68 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_MAPPED_FILE_H
+#define RATATOSKR_MAPPED_FILE_H
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <string_view>
+namespace ratatoskr {
+
+class InputFileError : public std::runtime_error {
+public:
+	using runtime_error::runtime_error;
+};
+
+/** @brief A file mapped read-only in memory for the lifetime of the object */
+class MappedFile {
+	const char* data_=nullptr;
+	size_t size_=0;
+public:
+	explicit MappedFile(const string& filename) {
+		int fd=open(filename.c_str(),O_RDONLY);
+		if (fd<0) throw InputFileError("cannot open "+filename);
+		struct stat status;
+		if (fstat(fd,&status)) {
+			close(fd);
+			throw InputFileError("cannot read "+filename);
+		}
+		size_=status.st_size;
+		if (size_) {
+			void* data=mmap(nullptr,size_,PROT_READ,MAP_PRIVATE,fd,0);
+			if (data==MAP_FAILED) {
+				close(fd);
+				throw InputFileError("cannot map "+filename);
+			}
+			data_=static_cast<const char*>(data);
+		}
+		close(fd);
+	}
+	MappedFile(const MappedFile&)=delete;
+	MappedFile& operator=(const MappedFile&)=delete;
+	MappedFile(MappedFile&& other) noexcept : data_{exchange(other.data_,nullptr)}, size_{exchange(other.size_,0)} {}
+	~MappedFile() {
+		if (data_) munmap(const_cast<char*>(data_),size_);
+	}
+	string_view contents() const {return {data_,size_};}
+};
+
+}
+#endif
@@ -19,7 +19,10 @@
  *******************************************************************************/
 #ifndef PAIR_FROM_H
 #define PAIR_FROM_H
+#include <charconv>
+#include <cctype>
 #include "splice.h"
+#include "../parameters/errors.h"
 
 namespace ratatoskr {
 /** @brief returns a pair object from a string. The string should be formatted as a sequence of two strings convertible to U and V, interleaved by a single character */
@@ -31,19 +34,48 @@ public:
 	} {}
 };
 
+class ValueParseError : public ParseError {
+public:
+	ValueParseError(string_view value) : ParseError{string{value}} {}
+};
+
+/** @brief Parses s as a value of type U, returning false if s is not entirely made of a valid value, surrounding spaces aside
+ *
+ * Numbers are parsed with std::from_chars, which does not allocate; strings are copied; other types are read from a stringstream.
+ */
 template<typename U>
-U from_string(const string& s) {
+bool parse_value(string_view s, U& result) {
+	while (!s.empty() && isspace(static_cast<unsigned char>(s.front()))) s.remove_prefix(1);
+	while (!s.empty() && isspace(static_cast<unsigned char>(s.back()))) s.remove_suffix(1);
+	if constexpr (is_arithmetic_v<U> && !is_same_v<U,bool>) {
+		if (s.size()>1 && s.front()=='+' && s[1]!='-') s.remove_prefix(1);
+		auto [end,error]=from_chars(s.data(),s.data()+s.size(),result);
+		return error==errc{} && end==s.data()+s.size();
+	}
+	else if constexpr (is_constructible_v<U,string_view>) {
+		result=U{s};
+		return true;
+	}
+	else {
+		std::stringstream str{string{s}};
+		return static_cast<bool>(str>>result);
+	}
+}
+
+template<typename U>
+U from_string(string_view s) {
 	U result;
-	std::stringstream str{s};
-	str>>result;
+	if (!parse_value(s,result)) throw ValueParseError(s);
 	return result;
 }
 
 template<typename U, typename V>
-std::pair<U,V> pair_from_string(const std::string& s, char sep) {
-	vector<string> elements=splice(s,sep);
-	if (elements.size()!=2) throw PairParseError(s,sep);
-	return make_pair(from_string<U>(elements[0]), from_string<V>(elements[1]));
+std::pair<U,V> pair_from_string(string_view s, char sep) {
+	auto separator=s.find(sep);
+	if (separator==string_view::npos || s.find(sep,separator+1)!=string_view::npos) throw PairParseError(string{s},sep);
+	std::pair<U,V> result;
+	if (!parse_value(s.substr(0,separator),result.first) || !parse_value(s.substr(separator+1),result.second)) throw PairParseError(string{s},sep);
+	return result;
 }
 
 template<typename U, typename V>
@@ -18,15 +18,31 @@
  *  
  *******************************************************************************/
 namespace ratatoskr {
+
+//calls f on each field of s separated by sep, as a view into s; n separators always give n+1 fields, possibly empty
+template<typename F>
+void for_each_field(string_view s, char sep, F&& f) {
+	while (true) {
+		auto end=s.find(sep);
+		if (end==string_view::npos) {
+			f(s);
+			return;
+		}
+		f(s.substr(0,end));
+		s.remove_prefix(end+1);
+	}
+}
+
+//the fields of s separated by sep, as views into s, which should outlive them
+inline vector<string_view> splice_view(string_view s, char sep=',') {
+	vector<string_view> result;
+	for_each_field(s,sep,[&result] (string_view field) {result.push_back(field);});
+	return result;
+}
+
 inline vector<string> splice(const string& s, char sep=',') {
 	vector<string> result;
-	int begin=0;
-	do {
-		int end=s.find(sep,begin);
-		if (end==string::npos) end=s.size();
-		result.push_back(s.substr(begin,end-begin));
-		begin=end+1;
-	} while (begin<s.size());
+	for_each_field(s,sep,[&result] (string_view field) {result.emplace_back(field);});
 	return result;
 }
 }
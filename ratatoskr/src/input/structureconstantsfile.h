@@ -0,0 +1,194 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_STRUCTURE_CONSTANTS_FILE_H
+#define RATATOSKR_STRUCTURE_CONSTANTS_FILE_H
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include "mappedfile.h"
+#include "../algebra/structureconstants.h"
+namespace ratatoskr {
+using namespace GiNaC;
+
+/** @file structureconstantsfile.h
+ * Files listing the nonzero structure constants c^k_{ij}, with de^k=\sum_{i<j} c^k_{ij}e^{ij} and 1-based indices, in one of two layouts.
+ *
+ * Text: the dimension, followed by one quadruple i j k c for each structure constant, where c is an integer or a fraction p/q.
+ * Whitespace and line breaks are interchangeable, and # starts a comment extending to the end of the line.
+ *
+ * Binary: the eight characters RTSKSC01, the dimension and the number of records as int64, then one record for each structure constant,
+ * made of five int64 i,j,k,p,q representing c=p/q. Integers are stored in native byte order.
+ */
+
+constexpr char structure_constants_magic[]="RTSKSC01";
+constexpr size_t structure_constants_magic_size=sizeof(structure_constants_magic)-1;
+
+//collects the structure constants, checking the indices and summing repeated entries; c^k_{ji} is interpreted as -c^k_{ij}
+class StructureConstantsBuilder {
+	int dimension;
+	map<tuple<int,int,int>,ex> constants;
+public:
+	explicit StructureConstantsBuilder(int dimension) : dimension{dimension} {
+		if (dimension<=0) throw InputFileError("dimension should be positive");
+	}
+	void add(int i, int j, int k, const ex& c) {
+		if (i<1 || i>dimension || j<1 || j>dimension || k<1 || k>dimension)
+			throw InputFileError("index out of range in structure constant ("+to_string(i)+","+to_string(j)+","+to_string(k)+")");
+		if (i==j) throw InputFileError("repeated index in structure constant ("+to_string(i)+","+to_string(j)+","+to_string(k)+")");
+		if (i<j) constants[{i,j,k}]+=c;
+		else constants[{j,i,k}]-=c;
+	}
+	StructureConstants structure_constants() const {
+		vector<StructureConstantTriple> triples;
+		for (auto& constant: constants)
+			if (!constant.second.is_zero()) triples.push_back({get<0>(constant.first),get<1>(constant.first),get<2>(constant.first),constant.second});
+		return {dimension,std::move(triples)};
+	}
+};
+
+class StructureConstantsTokenizer {
+	string_view contents;
+	void skip_blanks() {
+		while (!contents.empty()) {
+			if (contents[0]=='#') {
+				auto end_of_line=contents.find('\n');
+				contents.remove_prefix(end_of_line==string_view::npos? contents.size() : end_of_line);
+			}
+			else if (isspace(static_cast<unsigned char>(contents[0]))) contents.remove_prefix(1);
+			else break;
+		}
+	}
+public:
+	explicit StructureConstantsTokenizer(string_view contents) : contents{contents} {}
+	bool at_end() {
+		skip_blanks();
+		return contents.empty();
+	}
+	string_view next() {
+		skip_blanks();
+		if (contents.empty()) throw InputFileError("unexpected end of file in structure constants");
+		size_t length=0;
+		while (length<contents.size() && !isspace(static_cast<unsigned char>(contents[length])) && contents[length]!='#') ++length;
+		auto token=contents.substr(0,length);
+		contents.remove_prefix(length);
+		return token;
+	}
+	int next_int() {
+		auto token=next();
+		int result;
+		auto parsed=from_chars(token.data(),token.data()+token.size(),result);
+		if (parsed.ec!=errc{} || parsed.ptr!=token.data()+token.size()) throw InputFileError("expected an integer in structure constants, found "+string{token});
+		return result;
+	}
+	//an integer or a fraction; coefficients which do not fit in a machine word are parsed by GiNaC
+	ex next_rational() {
+		auto token=next();
+		auto end=token.data()+token.size();
+		long numerator, denominator=1;
+		auto parsed=from_chars(token.data(),end,numerator);
+		if (parsed.ec==errc{} && parsed.ptr!=end && *parsed.ptr=='/')
+			parsed=from_chars(parsed.ptr+1,end,denominator);
+		if (parsed.ec==errc{} && parsed.ptr==end && denominator) return numeric{numerator,denominator};
+		ex c;
+		bool parsed_by_ginac=true;
+		try {
+			c=ex{string{token},lst{}};
+		}
+		catch (const std::exception&) {
+			parsed_by_ginac=false;
+		}
+		if (!parsed_by_ginac || !c.info(info_flags::rational)) throw InputFileError("expected a rational number in structure constants, found "+string{token});
+		return c;
+	}
+};
+
+inline StructureConstants parse_structure_constants_text(string_view contents) {
+	StructureConstantsTokenizer tokens{contents};
+	StructureConstantsBuilder builder{tokens.next_int()};
+	while (!tokens.at_end()) {
+		int i=tokens.next_int(), j=tokens.next_int(), k=tokens.next_int();
+		builder.add(i,j,k,tokens.next_rational());
+	}
+	return builder.structure_constants();
+}
+
+inline StructureConstants parse_structure_constants_binary(string_view contents) {
+	auto read_int64=[&contents] (size_t offset) {
+		int64_t x;
+		memcpy(&x,contents.data()+offset,sizeof(x));
+		return x;
+	};
+	size_t header_size=structure_constants_magic_size+2*sizeof(int64_t), record_size=5*sizeof(int64_t);
+	if (contents.size()<header_size) throw InputFileError("truncated binary structure constants");
+	int64_t dimension=read_int64(structure_constants_magic_size), records=read_int64(structure_constants_magic_size+sizeof(int64_t));
+	if (records<0 || contents.size()!=header_size+records*record_size) throw InputFileError("binary structure constants: size does not match the number of records");
+	StructureConstantsBuilder builder(dimension);
+	for (int64_t r=0;r<records;++r) {
+		size_t offset=header_size+r*record_size;
+		int64_t denominator=read_int64(offset+4*sizeof(int64_t));
+		if (!denominator) throw InputFileError("binary structure constants: zero denominator");
+		builder.add(read_int64(offset),read_int64(offset+sizeof(int64_t)),read_int64(offset+2*sizeof(int64_t)),
+			numeric{read_int64(offset+3*sizeof(int64_t))}/numeric{denominator});
+	}
+	return builder.structure_constants();
+}
+
+inline bool is_binary_structure_constants(string_view contents) {
+	return contents.substr(0,structure_constants_magic_size)==string_view{structure_constants_magic,structure_constants_magic_size};
+}
+
+inline StructureConstants parse_structure_constants(string_view contents) {
+	return is_binary_structure_constants(contents)? parse_structure_constants_binary(contents) : parse_structure_constants_text(contents);
+}
+
+inline StructureConstants read_structure_constants(const string& filename) {
+	MappedFile file{filename};
+	try {
+		return parse_structure_constants(file.contents());
+	}
+	catch (const InputFileError& error) {
+		throw InputFileError(filename+": "+error.what());
+	}
+}
+
+inline void write_structure_constants_text(ostream& os, const StructureConstants& c) {
+	os<<c.Dimension()<<endl;
+	for (auto& triple: c.triples()) os<<triple.i<<" "<<triple.j<<" "<<triple.k<<" "<<triple.c<<endl;
+}
+
+inline bool fits_in_int64(const numeric& x) {
+	return x>=numeric{numeric_limits<int64_t>::min()} && x<=numeric{numeric_limits<int64_t>::max()};
+}
+
+inline void write_structure_constants_binary(ostream& os, const StructureConstants& c) {
+	auto write_int64=[&os] (int64_t x) {os.write(reinterpret_cast<const char*>(&x),sizeof(x));};
+	os.write(structure_constants_magic,structure_constants_magic_size);
+	write_int64(c.Dimension());
+	write_int64(c.triples().size());
+	for (auto& triple: c.triples()) {
+		if (!triple.c.info(info_flags::rational)) throw std::invalid_argument("write_structure_constants_binary: structure constants should be rational");
+		auto x=ex_to<numeric>(triple.c);
+		if (!fits_in_int64(x.numer()) || !fits_in_int64(x.denom())) throw std::invalid_argument("write_structure_constants_binary: structure constant "+to_canonical_string(x)+" too large");
+		for (int64_t y: {int64_t{triple.i},int64_t{triple.j},int64_t{triple.k},int64_t{x.numer().to_long()},int64_t{x.denom().to_long()}}) write_int64(y);
+	}
+}
+
+}
+#endif
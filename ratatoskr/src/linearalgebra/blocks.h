@@ -0,0 +1,126 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_BLOCKS_H
+#define RATATOSKR_BLOCKS_H
+#include "modular.h"
+#include "../batch/workers.h"
+namespace ratatoskr {
+using namespace GiNaC;
+using namespace Wedge;
+
+//assigns consecutive indices 0,1,... to the distinct elements of keys
+template<typename Key, typename Less=std::less<Key>>
+vector<int> enumerate_distinct(const vector<Key>& keys) {
+	map<Key,int,Less> indices;
+	vector<int> result;
+	for (auto& key: keys) result.push_back(indices.emplace(key,indices.size()).first->second);
+	return result;
+}
+
+//text representation of a sequence of sparse vectors with rational entries, used to transfer the kernel of a block from a worker process
+inline string serialize(const vector<SparseVector>& vectors) {
+	stringstream s;
+	s<<vectors.size()<<endl;
+	for (auto& v: vectors) {
+		s<<v.size();
+		for (auto& entry: v) s<<" "<<entry.first<<" "<<entry.second;
+		s<<endl;
+	}
+	return s.str();
+}
+
+inline vector<SparseVector> deserialize(istream& s) {
+	int size;
+	s>>size;
+	vector<SparseVector> result(size);
+	for (auto& v: result) {
+		int entries;
+		s>>entries;
+		for (int k=0;k<entries;++k) {
+			int i;
+			string x;
+			s>>i>>x;
+			v.emplace(i,ex{x,lst{}});
+		}
+	}
+	return result;
+}
+
+//blocks with fewer columns are solved in the calling process, since forking and serializing the kernel would cost more than solving them
+constexpr int min_parallel_block_columns=128;
+
+/** @brief The kernel of a matrix which is block diagonal up to a permutation of rows and columns
+ *
+ * Each column j belongs to the block column_block[j]; each row should only involve columns in the same block. The blocks are solved separately;
+ * if workers>1 and the entries are rational, the blocks with at least min_parallel_block_columns columns are solved in that many worker processes,
+ * provided there are at least two of them. The result coincides with exact_kernel(m).
+ */
+inline vector<SparseVector> block_kernel(const SparseMatrix& m, const vector<int>& column_block, int workers=1) {
+	int blocks=column_block.empty()? 0 : *max_element(column_block.begin(),column_block.end())+1;
+	vector<vector<int>> columns(blocks);
+	vector<int> local_index(m.columns());
+	for (int j=0;j<m.columns();++j) {
+		local_index[j]=columns[column_block[j]].size();
+		columns[column_block[j]].push_back(j);
+	}
+	vector<SparseMatrix> submatrices;
+	for (auto& block_columns: columns) submatrices.emplace_back(block_columns.size());
+	for (auto& row: m.row_vectors()) {
+		if (row.empty()) continue;
+		int block=column_block[row.begin()->first];
+		SparseVector local_row;
+		for (auto& entry: row) {
+			if (column_block[entry.first]!=block) throw std::logic_error("block_kernel: row involving more than one block");
+			local_row.emplace(local_index[entry.first],entry.second);
+		}
+		submatrices[block].add_row(std::move(local_row));
+	}
+	auto solve=[&submatrices,&columns] (int block) {
+		vector<SparseVector> kernel;
+		for (auto& v: exact_kernel(submatrices[block])) {
+			SparseVector global;
+			for (auto& entry: v) global.emplace(columns[block][entry.first],entry.second);
+			kernel.push_back(std::move(global));
+		}
+		return kernel;
+	};
+	vector<int> large_blocks;
+	if (workers>1 && is_rational(m))
+		for (int block=0;block<blocks;++block)
+			if (columns[block].size()>=min_parallel_block_columns) large_blocks.push_back(block);
+	if (large_blocks.size()<2) large_blocks.clear();
+	vector<SparseVector> result;
+	auto append=[&result] (vector<SparseVector> kernel) {
+		for (auto& v: kernel) result.push_back(std::move(v));
+	};
+	if (!large_blocks.empty()) {
+		stringstream output;
+		run_jobs(large_blocks.size(),workers,[&solve,&large_blocks] (int i) {return serialize(solve(large_blocks[i]));},output);
+		for (int i=0;i<large_blocks.size();++i) append(deserialize(output));
+	}
+	for (int block=0;block<blocks;++block)
+		if (!binary_search(large_blocks.begin(),large_blocks.end(),block)) append(solve(block));
+	//the free column of each element of the kernel is its last nonzero entry
+	sort(result.begin(),result.end(),[] (auto& v, auto& w) {return v.rbegin()->first<w.rbegin()->first;});
+	return result;
+}
+
+}
+#endif
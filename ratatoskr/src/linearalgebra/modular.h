@@ -0,0 +1,243 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_MODULAR_H
+#define RATATOSKR_MODULAR_H
+#include <cstdint>
+#include "sparsematrix.h"
+namespace ratatoskr {
+using namespace GiNaC;
+using namespace Wedge;
+
+namespace modular {
+using residue=uint64_t;
+
+inline bool is_prime(residue n) {
+	if (n<2) return false;
+	for (residue d=2;d*d<=n;++d)
+		if (n%d==0) return false;
+	return true;
+}
+
+//primes below 2^31, in decreasing order, so that products of residues fit in 64 bits
+class PrimeSequence {
+	residue current=residue{1}<<31;
+public:
+	residue next() {
+		do --current; while (!is_prime(current));
+		return current;
+	}
+};
+
+inline residue inverse(residue a, residue p) {
+	int64_t r0=p, r1=a, t0=0, t1=1;
+	while (r1) {
+		int64_t q=r0/r1;
+		r0=exchange(r1,r0-q*r1);
+		t0=exchange(t1,t0-q*t1);
+	}
+	if (r0!=1) throw std::invalid_argument("modular::inverse: element not invertible");
+	return t0<0? t0+p : t0;
+}
+
+inline residue reduce(const numeric& x, residue p) {
+	return mod(x,numeric{static_cast<long>(p)}).to_long();
+}
+
+using ModularRow=map<int,residue>;
+
+/** @brief Reduced row echelon form modulo p, represented by the pivot rows indexed by their pivot column; each pivot equals 1 */
+inline map<int,ModularRow> reduced_row_echelon_form(vector<ModularRow> rows, residue p) {
+	//row-=coefficient*pivot_row
+	auto subtract=[p] (ModularRow& row, residue coefficient, const ModularRow& pivot_row) {
+		for (auto& entry: pivot_row) {
+			auto& x=row[entry.first];
+			x=(x+(p-coefficient)*entry.second)%p;
+			if (!x) row.erase(entry.first);
+		}
+	};
+	map<int,ModularRow> pivots;
+	for (auto& row : rows) {
+		for (auto i=row.begin();i!=row.end();) {
+			auto pivot=pivots.find(i->first);
+			if (pivot==pivots.end()) {++i; continue;}
+			int column=i->first;
+			subtract(row,residue{i->second},pivot->second);
+			i=row.upper_bound(column);
+		}
+		if (row.empty()) continue;
+		int column=row.begin()->first;
+		residue inverse_leading=inverse(row.begin()->second,p);
+		for (auto& entry: row) entry.second=entry.second*inverse_leading%p;
+		pivots.emplace(column,std::move(row));
+	}
+	for (auto pivot=pivots.rbegin();pivot!=pivots.rend();++pivot)
+		for (auto& other: pivots) {
+			if (other.first>=pivot->first) break;
+			auto entry=other.second.find(pivot->first);
+			if (entry!=other.second.end()) subtract(other.second,residue{entry->second},pivot->second);
+		}
+	return pivots;
+}
+
+//the rational number a/b with |a|,|b|<=\sqrt{m/2} congruent to u modulo m, if it exists
+inline bool rational_reconstruction(const numeric& u, const numeric& m, numeric& result) {
+	numeric r0=m, r1=u, t0=0, t1=1;
+	numeric bound=isqrt(iquo(m,2));
+	while (r1>bound) {
+		numeric q=iquo(r0,r1);
+		r0=exchange(r1,r0-q*r1);
+		t0=exchange(t1,t0-q*t1);
+	}
+	if (t1.is_zero() || abs(t1)>bound || gcd(r1,t1)!=1) return false;
+	result=r1/t1;
+	return true;
+}
+
+using IntegerRow=vector<pair<int,numeric>>;
+
+//the rows of a matrix with rational entries, each multiplied by the lcm of its denominators
+inline vector<IntegerRow> integer_rows(const SparseMatrix& m) {
+	vector<IntegerRow> result;
+	for (auto& row : m.row_vectors()) {
+		numeric denominator=1;
+		for (auto& entry : row) denominator=lcm(denominator,ex_to<numeric>(entry.second).denom());
+		IntegerRow integer_row;
+		for (auto& entry : row) integer_row.emplace_back(entry.first,ex_to<numeric>(entry.second)*denominator);
+		result.push_back(std::move(integer_row));
+	}
+	return result;
+}
+
+//the reduced row echelon form of m modulo p is better than another if it has more pivots, or the same number of pivots occurring earlier
+inline bool better_pivots(const vector<int>& pivots, const vector<int>& other) {
+	if (pivots.size()!=other.size()) return pivots.size()>other.size();
+	return pivots<other;
+}
+}
+
+//true if all the entries of m are rational numbers
+inline bool is_rational(const SparseMatrix& m) {
+	for (auto& row : m.row_vectors())
+		for (auto& entry : row)
+			if (!entry.second.info(info_flags::rational)) return false;
+	return true;
+}
+
+/** @brief The kernel of a matrix with rational entries, computed modulo word-size primes
+ *
+ * The reduced row echelon form is computed modulo a sequence of primes; primes where the pivots are not the expected ones are discarded.
+ * The entries are lifted by Chinese remaindering and rational reconstruction until the reconstruction stabilizes, and the resulting
+ * basis is verified against the original matrix over the integers. The result coincides with SparseMatrix::Kernel().
+ */
+inline vector<SparseVector> modular_kernel(const SparseMatrix& m) {
+	using namespace modular;
+	auto rows=integer_rows(m);
+	PrimeSequence primes;
+	vector<int> pivots;
+	bool first=true;
+	numeric modulus;
+	map<pair<int,int>,numeric> lifted;				//lifted entries of the reduced row echelon form, indexed by (pivot,column)
+	map<pair<int,int>,numeric> reconstructed;
+	while (true) {
+		residue p=primes.next();
+		vector<ModularRow> reduced_rows;
+		for (auto& row : rows) {
+			ModularRow reduced_row;
+			for (auto& entry : row) {
+				residue x=reduce(entry.second,p);
+				if (x) reduced_row.emplace(entry.first,x);
+			}
+			reduced_rows.push_back(std::move(reduced_row));
+		}
+		auto rref=reduced_row_echelon_form(std::move(reduced_rows),p);
+		vector<int> rref_pivots;
+		for (auto& pivot : rref) rref_pivots.push_back(pivot.first);
+		if (first || better_pivots(rref_pivots,pivots)) {
+			pivots=std::move(rref_pivots);
+			modulus=1;
+			lifted.clear();
+			reconstructed.clear();
+			first=false;
+		}
+		else if (rref_pivots!=pivots) continue;
+		numeric P{static_cast<long>(p)};
+		residue modulus_inverse=inverse(reduce(modulus,p),p);
+		for (auto& pivot : rref)
+			for (auto& entry : pivot.second)
+				if (entry.first!=pivot.first) lifted.emplace(make_pair(pivot.first,entry.first),0);
+		for (auto& x : lifted) {
+			auto& row=rref[x.first.first];
+			auto entry=row.find(x.first.second);
+			residue r=entry==row.end()? 0 : entry->second;
+			residue t=(r+p-reduce(x.second,p))%p*modulus_inverse%p;
+			x.second+=modulus*numeric{static_cast<long>(t)};
+		}
+		modulus*=P;
+		map<pair<int,int>,numeric> reconstruction;
+		bool success=true;
+		for (auto& x : lifted) {
+			numeric q;
+			if (!(success=rational_reconstruction(x.second,modulus,q))) break;
+			if (!q.is_zero()) reconstruction.emplace(x.first,q);
+		}
+		if (!success) {
+			reconstructed.clear();
+			continue;
+		}
+		if (reconstruction!=reconstructed) {
+			reconstructed=std::move(reconstruction);
+			continue;
+		}
+		vector<SparseVector> kernel;
+		for (int free=0;free<m.columns();++free) {
+			if (binary_search(pivots.begin(),pivots.end(),free)) continue;
+			SparseVector v{{free,1}};
+			for (int pivot : pivots) {
+				auto entry=reconstructed.find({pivot,free});
+				if (entry!=reconstructed.end()) v[pivot]=-entry->second;
+			}
+			kernel.push_back(std::move(v));
+		}
+		auto in_kernel=[&rows] (const SparseVector& v) {
+			for (auto& row : rows) {
+				numeric x;
+				for (auto& entry : row) {
+					auto i=v.find(entry.first);
+					if (i!=v.end()) x+=entry.second*ex_to<numeric>(i->second);
+				}
+				if (!x.is_zero()) return false;
+			}
+			return true;
+		};
+		if (all_of(kernel.begin(),kernel.end(),in_kernel)) return kernel;
+	}
+}
+
+//the kernel of m, computed by modular methods if all entries are rational
+inline vector<SparseVector> exact_kernel(const SparseMatrix& m) {
+	return is_rational(m)? modular_kernel(m) : m.Kernel();
+}
+
+inline int exact_rank(const SparseMatrix& m) {
+	return is_rational(m)? m.columns()-modular_kernel(m).size() : m.Rank();
+}
+
+}
+#endif
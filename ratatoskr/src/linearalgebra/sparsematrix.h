@@ -0,0 +1,159 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_SPARSE_MATRIX_H
+#define RATATOSKR_SPARSE_MATRIX_H
+namespace ratatoskr {
+using namespace GiNaC;
+using namespace Wedge;
+
+//a sparse vector, mapping indices to nonzero entries
+using SparseVector=map<int,ex>;
+
+//maps each element of a basis of symbols (e.g. spinors or one-forms) to its position
+inline map<ex,int,ex_is_less> index_of_basis(const exvector& basis) {
+	map<ex,int,ex_is_less> result;
+	for (int i=0;i<basis.size();++i) result.emplace(basis[i],i);
+	return result;
+}
+
+/** @brief Components of a linear combination of the elements of a basis, indexed by index_of_basis
+ *
+ * Assumes that v, once expanded, is a sum of terms each containing exactly one element of the basis.
+ */
+inline SparseVector components_in_basis(const ex& v, const map<ex,int,ex_is_less>& basis) {
+	SparseVector result;
+	auto add_term=[&result,&basis] (const ex& term) {
+		auto i=basis.find(term);
+		if (i!=basis.end()) {
+			result[i->second]+=1;
+			return;
+		}
+		if (is_a<mul>(term))
+			for (auto& factor : term)
+				if ((i=basis.find(factor))!=basis.end()) {
+					result[i->second]+=term/factor;
+					return;
+				}
+		throw std::invalid_argument("components_in_basis: "+to_canonical_string(term)+" is not a multiple of a basis element");
+	};
+	ex expanded=v.expand();
+	if (is_a<add>(expanded))
+		for (auto& term : expanded) add_term(term);
+	else if (!expanded.is_zero()) add_term(expanded);
+	for (auto i=result.begin();i!=result.end();)
+		if (i->second.is_zero()) i=result.erase(i);
+		else ++i;
+	return result;
+}
+
+/** @brief A matrix stored as a sequence of sparse rows, with exact arithmetic on GiNaC expressions */
+class SparseMatrix {
+	int columns_;
+	vector<SparseVector> rows_;
+	static ex simplify(const ex& x) {return x.normal();}
+	//row-=coefficient*pivot_row
+	static void subtract(SparseVector& row, const ex& coefficient, const SparseVector& pivot_row) {
+		for (auto& entry: pivot_row) {
+			ex x=simplify(row[entry.first]-coefficient*entry.second);
+			if (x.is_zero()) row.erase(entry.first);
+			else row[entry.first]=x;
+		}
+	}
+	//reduces row against the pivot rows; if the result is nonzero, it is normalized and added to the pivots, and true is returned
+	static bool add_to_echelon_form(SparseVector row, map<int,SparseVector>& pivots) {
+		for (auto i=row.begin();i!=row.end();) {
+			auto pivot=pivots.find(i->first);
+			if (pivot==pivots.end()) {++i; continue;}
+			int column=i->first;
+			subtract(row,ex{i->second},pivot->second);
+			i=row.upper_bound(column);
+		}
+		if (row.empty()) return false;
+		int column=row.begin()->first;
+		ex leading=row.begin()->second;
+		for (auto& entry: row) entry.second=simplify(entry.second/leading);
+		pivots.emplace(column,std::move(row));
+		return true;
+	}
+public:
+	explicit SparseMatrix(int columns) : columns_{columns} {}
+	int columns() const {return columns_;}
+	int rows() const {return rows_.size();}
+	const vector<SparseVector>& row_vectors() const {return rows_;}
+	void add_row(SparseVector row) {
+		for (auto i=row.begin();i!=row.end();)
+			if (i->second.is_zero()) i=row.erase(i);
+			else ++i;
+		rows_.push_back(std::move(row));
+	}
+	//appends the rows of another matrix with the same number of columns
+	void append(const SparseMatrix& other) {
+		assert(other.columns_==columns_);
+		rows_.insert(rows_.end(),other.rows_.begin(),other.rows_.end());
+	}
+	//adds coefficient*other to this matrix, assuming the dimensions coincide
+	SparseMatrix& add(const SparseMatrix& other, const ex& coefficient=1) {
+		assert(other.columns_==columns_ && other.rows_.size()==rows_.size());
+		for (int i=0;i<rows_.size();++i)
+			subtract(rows_[i],-coefficient,other.rows_[i]);
+		return *this;
+	}
+	/** @brief Reduced row echelon form, represented by the pivot rows indexed by their pivot column; each pivot equals 1 */
+	map<int,SparseVector> ReducedRowEchelonForm() const {
+		map<int,SparseVector> pivots;
+		for (auto& row : rows_) add_to_echelon_form(row,pivots);
+		for (auto pivot=pivots.rbegin();pivot!=pivots.rend();++pivot)
+			for (auto& other: pivots) {
+				if (other.first>=pivot->first) break;
+				auto entry=other.second.find(pivot->first);
+				if (entry!=other.second.end()) subtract(other.second,ex{entry->second},pivot->second);
+			}
+		return pivots;
+	}
+	int Rank() const {
+		return ReducedRowEchelonForm().size();
+	}
+	//the indices of the rows which are not linear combinations of the preceding rows
+	vector<int> IndependentRows() const {
+		map<int,SparseVector> pivots;
+		vector<int> result;
+		for (int i=0;i<rows_.size();++i)
+			if (add_to_echelon_form(rows_[i],pivots)) result.push_back(i);
+		return result;
+	}
+	//a basis of the kernel, with one element for each non-pivot column
+	vector<SparseVector> Kernel() const {
+		auto pivots=ReducedRowEchelonForm();
+		vector<SparseVector> result;
+		for (int free=0;free<columns_;++free) {
+			if (pivots.count(free)) continue;
+			SparseVector v{{free,1}};
+			for (auto& pivot: pivots) {
+				auto entry=pivot.second.find(free);
+				if (entry!=pivot.second.end()) v[pivot.first]=-entry->second;
+			}
+			result.push_back(std::move(v));
+		}
+		return result;
+	}
+};
+
+}
+#endif
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_ZERO_TEST_H
+#define RATATOSKR_ZERO_TEST_H
+#include <random>
+namespace ratatoskr {
+using namespace GiNaC;
+
+inline exset symbols_in(const ex& x) {
+	exset result;
+	for (auto i=x.preorder_begin();i!=x.preorder_end();++i)
+		if (is_a<symbol>(*i)) result.insert(*i);
+	return result;
+}
+
+//a point with random rational coordinates, whose numerators and denominators have at most 20 bits
+inline exmap random_rational_point(const exset& symbols, mt19937_64& engine) {
+	const long range=1<<20;
+	exmap point;
+	for (auto& x: symbols) point[x]=numeric(static_cast<long>(engine()%(2*range+1))-range,static_cast<long>(engine()%range)+1);
+	return point;
+}
+
+/** @brief Zero test for large expressions, which evaluates them at random rational points before resorting to normal()
+ *
+ * An expression is certainly nonzero if it takes a value which is a nonzero rational number, or a nonzero number whose floating-point approximation is not small.
+ * If the expression vanishes at all the points, it is probably zero: by the Schwartz-Zippel lemma, a nonzero rational function of degree d vanishes at a random point
+ * with probability at most about d/2^20, so that the confidence can be increased by testing more points.
+ */
+class ZeroTest {
+	int points;
+	mt19937_64 engine;
+	static constexpr int attempts_per_point=3;
+	static bool certainly_nonzero_value(const ex& value) {
+		if (value.is_zero()) return false;
+		if (value.info(info_flags::rational)) return true;
+		ex approximation=value.evalf();
+		return is_a<numeric>(approximation) && abs(ex_to<numeric>(approximation))>numeric(1,1000000) && !value.normal().is_zero();
+	}
+public:
+	explicit ZeroTest(int points=3, uint64_t seed=mt19937_64::default_seed) : points{points}, engine{seed} {}
+	//false if x is certainly nonzero; true if x vanishes at all the random points, or if the points are poles
+	bool probably_zero(const ex& x) {
+		auto symbols=symbols_in(x);
+		if (symbols.empty()) return !certainly_nonzero_value(x);
+		int evaluated=0;
+		for (int attempt=0;attempt<points*attempts_per_point && evaluated<points;++attempt) {
+			ex value;
+			try {
+				value=x.subs(random_rational_point(symbols,engine));
+			}
+			catch (const std::exception&) {
+				continue;	//the point is a pole
+			}
+			if (certainly_nonzero_value(value)) return false;
+			++evaluated;
+		}
+		return true;
+	}
+	//exact zero test, where normal() is only computed if the expression is probably zero
+	bool is_zero(const ex& x) {
+		return x.is_zero() || (probably_zero(x) && x.normal().is_zero());
+	}
+	bool is_zero_matrix(const matrix& m) {
+		for (int i=0;i<m.rows();++i)
+		for (int j=0;j<m.cols();++j)
+			if (!probably_zero(m(i,j))) return false;
+		for (int i=0;i<m.rows();++i)
+		for (int j=0;j<m.cols();++j)
+			if (!m(i,j).is_zero() && !m(i,j).normal().is_zero()) return false;
+		return true;
+	}
+};
+
+}
+#endif
@@ -0,0 +1,128 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_BUFFERED_OUTPUT_H
+#define RATATOSKR_BUFFERED_OUTPUT_H
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <streambuf>
+namespace ratatoskr {
+
+/** @brief A stream buffer writing to a file descriptor through a large buffer
+ *
+ * The flushes requested by std::endl and std::flush do not reach the file descriptor, unless a flush interval is set and it has elapsed since the last write;
+ * the buffer is written out when it is full, by write_out() at the end of each job, and on destruction.
+ */
+class BufferedOutput : public streambuf {
+	int fd;
+	bool owns_fd;
+	vector<char> buffer;
+	chrono::steady_clock::duration flush_interval;
+	chrono::steady_clock::time_point last_write;
+protected:
+	bool write_fd(const char* p, size_t size) {
+		while (size) {
+			auto written=::write(fd,p,size);
+			if (written<0 && errno==EINTR) continue;
+			if (written<=0) return false;
+			p+=written;
+			size-=written;
+		}
+		return true;
+	}
+	//hooks for derived classes transforming the data, e.g. compressing it: write_data receives the contents of the buffer, flush_data is called when the flush interval elapses
+	virtual bool write_data(const char* p, size_t size) {return write_fd(p,size);}
+	virtual bool flush_data() {return true;}
+	bool write_buffer() {
+		if (!write_data(pbase(),pptr()-pbase())) return false;
+		setp(buffer.data(),buffer.data()+buffer.size());
+		last_write=chrono::steady_clock::now();
+		return true;
+	}
+	//drops the contents of the buffer, e.g. when they cannot be written out in the form required by a derived class
+	void discard_buffer() {
+		setp(buffer.data(),buffer.data()+buffer.size());
+	}
+	int_type overflow(int_type c) override {
+		if (!write_buffer()) return traits_type::eof();
+		if (traits_type::eq_int_type(c,traits_type::eof())) return traits_type::not_eof(c);
+		*pptr()=traits_type::to_char_type(c);
+		pbump(1);
+		return c;
+	}
+	int sync() override {
+		if (flush_interval==chrono::steady_clock::duration::zero() || chrono::steady_clock::now()-last_write<flush_interval) return 0;
+		return write_through()? 0 : -1;
+	}
+public:
+	static constexpr size_t default_buffer_size=1<<20;
+	//writes to fd, which is closed on destruction if owns_fd is true; a zero flush interval means that output is only written out at the end of each job
+	BufferedOutput(int fd, bool owns_fd, chrono::steady_clock::duration flush_interval=chrono::steady_clock::duration::zero(), size_t buffer_size=default_buffer_size)
+		: fd{fd}, owns_fd{owns_fd}, buffer(buffer_size), flush_interval{flush_interval}, last_write{chrono::steady_clock::now()} {
+		setp(buffer.data(),buffer.data()+buffer.size());
+	}
+	BufferedOutput(const BufferedOutput&)=delete;
+	BufferedOutput& operator=(const BufferedOutput&)=delete;
+	~BufferedOutput() {
+		write_buffer();
+		if (owns_fd) close(fd);
+	}
+	//writes out the buffer at the end of a job
+	virtual bool write_out() {return write_buffer();}
+	//writes out the buffer, so that the data written so far can be read on the other end, without marking the end of a job
+	bool write_through() {return write_buffer() && flush_data();}
+};
+
+class OutputFileError : public CommandLineError {
+public:
+	OutputFileError(const string& filename) : CommandLineError{"cannot write to "+filename} {}
+};
+
+//opens a file for writing, truncating it if it exists
+inline int open_output_file(const string& filename) {
+	int fd=open(filename.c_str(),O_WRONLY|O_CREAT|O_TRUNC,0644);
+	if (fd<0) throw OutputFileError(filename);
+	return fd;
+}
+
+//a buffered output for a file, truncated if it exists
+inline unique_ptr<BufferedOutput> buffered_output_to_file(const string& filename, chrono::steady_clock::duration flush_interval) {
+	return make_unique<BufferedOutput>(open_output_file(filename),true,flush_interval);
+}
+
+//marks the end of a record within the output of a job, which is written out immediately; other streams are flushed
+inline void end_of_record(ostream& os) {
+	if (auto buffer=dynamic_cast<BufferedOutput*>(os.rdbuf())) {
+		if (!buffer->write_through()) os.setstate(ios::badbit);
+	}
+	else os.flush();
+}
+
+//marks the end of the output of a job; buffered output is written out, other streams are flushed
+inline void end_of_job(ostream& os) {
+	if (auto buffer=dynamic_cast<BufferedOutput*>(os.rdbuf())) {
+		if (!buffer->write_out()) os.setstate(ios::badbit);
+	}
+	else os.flush();
+}
+
+}
+#endif
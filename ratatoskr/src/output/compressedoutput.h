@@ -0,0 +1,143 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_COMPRESSED_OUTPUT_H
+#define RATATOSKR_COMPRESSED_OUTPUT_H
+#include <zlib.h>
+#include <cstdint>
+#include "bufferedoutput.h"
+namespace ratatoskr {
+
+enum class Compression {none, gzip};
+
+/** @brief A buffered output compressing its data into a sequence of gzip members, one for each job
+ *
+ * Data is compressed incrementally as the buffer fills, so that memory usage does not depend on the size of the output. Each call to write_out() terminates
+ * a gzip member, which can be decompressed independently of the others; the concatenation is itself a valid gzip file. If an index file descriptor is given,
+ * a line "offset compressed_size uncompressed_size" is appended to it for each member, so that the output of the n-th job can be located from the n-th line.
+ * When a flush interval is set and elapses, the compressed data is flushed with Z_SYNC_FLUSH, so that it can be decompressed up to that point.
+ */
+class CompressedOutput : public BufferedOutput {
+	z_stream stream{};
+	vector<unsigned char> compressed;
+	int index_fd;
+	bool owns_index_fd;
+	uint64_t offset=0, member_start=0;
+	bool member_open=false;
+	bool deflate_data(const char* p, size_t size, int flush) {
+		stream.next_in=reinterpret_cast<Bytef*>(const_cast<char*>(p));
+		stream.avail_in=size;
+		int result;
+		do {
+			stream.next_out=compressed.data();
+			stream.avail_out=compressed.size();
+			result=deflate(&stream,flush);
+			if (result==Z_STREAM_ERROR) return false;
+			auto produced=compressed.size()-stream.avail_out;
+			if (!write_fd(reinterpret_cast<const char*>(compressed.data()),produced)) return false;
+			offset+=produced;
+		} while (stream.avail_out==0 || (flush==Z_FINISH && result!=Z_STREAM_END));
+		return true;
+	}
+	bool finish_member() {
+		if (!deflate_data(nullptr,0,Z_FINISH)) return false;
+		if (index_fd>=0) {
+			auto line=to_string(member_start)+" "+to_string(offset-member_start)+" "+to_string(stream.total_in)+"\n";
+			while (true) {
+				auto written=::write(index_fd,line.data(),line.size());
+				if (written<0 && errno==EINTR) continue;
+				if (written!=static_cast<ssize_t>(line.size())) return false;
+				break;
+			}
+		}
+		deflateReset(&stream);
+		member_start=offset;
+		member_open=false;
+		return true;
+	}
+protected:
+	bool write_data(const char* p, size_t size) override {
+		if (!size) return true;
+		member_open=true;
+		return deflate_data(p,size,Z_NO_FLUSH);
+	}
+	bool flush_data() override {
+		return !member_open || deflate_data(nullptr,0,Z_SYNC_FLUSH);
+	}
+public:
+	//writes to fd, and to index_fd unless it is negative; both are closed on destruction if owns_fd is true
+	CompressedOutput(int fd, int index_fd, bool owns_fd, chrono::steady_clock::duration flush_interval=chrono::steady_clock::duration::zero(), int level=Z_DEFAULT_COMPRESSION)
+		: BufferedOutput{fd,owns_fd,flush_interval}, compressed(1<<16), index_fd{index_fd}, owns_index_fd{owns_fd} {
+		//15 is the largest window size; adding 16 selects the gzip format
+		if (deflateInit2(&stream,level,Z_DEFLATED,15+16,8,Z_DEFAULT_STRATEGY)!=Z_OK) {
+			if (owns_index_fd && index_fd>=0) close(index_fd);
+			throw runtime_error("cannot initialize zlib");
+		}
+	}
+	~CompressedOutput() {
+		if (!write_buffer() || (member_open && !finish_member())) {
+			//otherwise ~BufferedOutput would write the remaining data uncompressed
+			discard_buffer();
+			cerr<<"cannot write compressed output"<<endl;
+		}
+		deflateEnd(&stream);
+		if (owns_index_fd && index_fd>=0) close(index_fd);
+	}
+	bool write_out() override {
+		return write_buffer() && finish_member();
+	}
+};
+
+class InvalidCompression : public CommandLineError {
+public:
+	InvalidCompression(const string& compression) : CommandLineError{"unsupported compression "+compression+"; the supported compression is gzip"} {}
+};
+
+inline Compression compression_from_name(const string& name) {
+	if (name=="none") return Compression::none;
+	if (name=="gzip" || name=="gz") return Compression::gzip;
+	throw InvalidCompression(name);
+}
+
+//the compression implied by the suffix of a file name, e.g. gzip for .gz
+inline Compression compression_from_suffix(const string& filename) {
+	auto dot=filename.rfind('.');
+	if (dot==string::npos || filename.find('/',dot)!=string::npos) return Compression::none;
+	auto suffix=filename.substr(dot+1);
+	if (suffix=="gz") return Compression::gzip;
+	if (suffix=="zst") throw InvalidCompression("zstd");
+	return Compression::none;
+}
+
+//a compressed output for a file, truncated if it exists, with the index of the gzip members written to filename.index
+inline unique_ptr<BufferedOutput> compressed_output_to_file(const string& filename, chrono::steady_clock::duration flush_interval) {
+	int fd=open_output_file(filename);
+	int index_fd;
+	try {
+		index_fd=open_output_file(filename+".index");
+	}
+	catch (...) {
+		close(fd);
+		throw;
+	}
+	return make_unique<CompressedOutput>(fd,index_fd,true,flush_interval);
+}
+
+}
+#endif
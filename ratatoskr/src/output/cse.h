@@ -0,0 +1,81 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_CSE_H
+#define RATATOSKR_CSE_H
+#include <unordered_map>
+namespace ratatoskr {
+using namespace GiNaC;
+
+namespace detail {
+	struct MapFunction : map_function {
+		const function<ex(const ex&)>& f;
+		explicit MapFunction(const function<ex(const ex&)>& f) : f{f} {}
+		ex operator()(const ex& x) override {return f(x);}
+	};
+}
+
+/** @brief Expressions rewritten in terms of temporaries standing for their common subexpressions
+ *
+ * Each temporary is defined by an expression involving the previous temporaries only.
+ */
+struct CommonSubexpressions {
+	vector<pair<symbol,ex>> temporaries;
+	exvector expressions;
+};
+
+/** @brief Replaces the subexpressions occurring more than once in the given expressions by temporaries named prefix1, prefix2,...
+ *
+ * Subexpressions are compared structurally, as nodes of the expression trees; only those with at least minimum_size nodes are replaced, so that
+ * symbols, numbers and small products are printed in place.
+ */
+inline CommonSubexpressions common_subexpressions(const exvector& expressions, int minimum_size=8, const string& prefix="cse") {
+	unordered_map<ex,int,ex_hash,ex_is_equal> occurrences, size;
+	//returns the number of nodes of x; the subexpressions of a repeated subexpression are only counted once
+	function<int(const ex&)> count=[&] (const ex& x) {
+		if (is_a<symbol>(x) || is_a<numeric>(x)) return 1;
+		if (occurrences[x]++) return size[x];
+		int nodes=1;
+		for (int i=0;i<x.nops();++i) nodes+=count(x.op(i));
+		return size[x]=nodes;
+	};
+	for (auto& x: expressions) count(x);
+
+	CommonSubexpressions result;
+	unordered_map<ex,ex,ex_hash,ex_is_equal> replacement;
+	function<ex(const ex&)> replace;
+	detail::MapFunction replace_operands{replace};
+	replace=[&] (const ex& x) -> ex {
+		if (is_a<symbol>(x) || is_a<numeric>(x)) return x;
+		auto known=replacement.find(x);
+		if (known!=replacement.end()) return known->second;
+		ex rewritten=x.map(replace_operands);
+		if (occurrences[x]>1 && size[x]>=minimum_size && !is_a<matrix>(x) && !is_a<lst>(x)) {
+			symbol temporary{prefix+to_string(result.temporaries.size()+1)};
+			result.temporaries.emplace_back(temporary,rewritten);
+			rewritten=temporary;
+		}
+		return replacement[x]=rewritten;
+	};
+	for (auto& x: expressions) result.expressions.push_back(replace(x));
+	return result;
+}
+
+}
+#endif
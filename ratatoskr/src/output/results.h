@@ -0,0 +1,361 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_RESULTS_H
+#define RATATOSKR_RESULTS_H
+#include <exception>
+#include <tuple>
+#include "bufferedoutput.h"
+#include "cse.h"
+namespace ratatoskr {
+using namespace GiNaC;
+
+enum class OutputFormat {text, json, archive};
+
+//the index of the word of a stream which holds its OutputFormat
+inline int output_format_index() {
+	static const int index=ios_base::xalloc();
+	return index;
+}
+inline OutputFormat output_format(ios_base& s) {
+	return static_cast<OutputFormat>(s.iword(output_format_index()));
+}
+inline ostream& text_output(ostream& os) {
+	os.iword(output_format_index())=static_cast<long>(OutputFormat::text);
+	return os;
+}
+inline ostream& json_output(ostream& os) {
+	os.iword(output_format_index())=static_cast<long>(OutputFormat::json);
+	return os;
+}
+inline ostream& archive_output(ostream& os) {
+	os.iword(output_format_index())=static_cast<long>(OutputFormat::archive);
+	return os;
+}
+
+//the index of the word of a stream which is nonzero if common subexpressions are to be replaced by temporaries
+inline int cse_index() {
+	static const int index=ios_base::xalloc();
+	return index;
+}
+inline bool cse_enabled(ios_base& s) {
+	return s.iword(cse_index());
+}
+inline ostream& cse_output(ostream& os) {
+	os.iword(cse_index())=1;
+	return os;
+}
+inline ostream& no_cse_output(ostream& os) {
+	os.iword(cse_index())=0;
+	return os;
+}
+
+//the index of the word of a stream which is nonzero if matrices are to be written as lists of nonzero entries
+inline int sparse_index() {
+	static const int index=ios_base::xalloc();
+	return index;
+}
+inline bool sparse_enabled(ios_base& s) {
+	return s.iword(sparse_index());
+}
+inline ostream& sparse_output(ostream& os) {
+	os.iword(sparse_index())=1;
+	return os;
+}
+inline ostream& dense_output(ostream& os) {
+	os.iword(sparse_index())=0;
+	return os;
+}
+
+enum class MatrixSymmetry {none, symmetric, antisymmetric};
+
+inline MatrixSymmetry matrix_symmetry(const matrix& m) {
+	if (m.rows()!=m.cols()) return MatrixSymmetry::none;
+	//the entries may be rational functions, e.g. for generic metrics, whose differences only vanish after normalization
+	auto holds=[&m] (int sign) {
+		for (int i=0;i<m.rows();++i)
+		for (int j=i;j<m.cols();++j)
+			if (!(m(i,j)-sign*m(j,i)).normal().is_zero()) return false;
+		return true;
+	};
+	if (holds(1)) return MatrixSymmetry::symmetric;
+	if (holds(-1)) return MatrixSymmetry::antisymmetric;
+	return MatrixSymmetry::none;
+}
+
+/** @brief The nonzero entries of a matrix, as triples (i,j,m(i,j)) with indices starting from 1
+ *
+ * For symmetric and antisymmetric matrices, only the entries on or above the diagonal are listed.
+ */
+inline vector<tuple<int,int,ex>> nonzero_entries(const matrix& m, MatrixSymmetry symmetry) {
+	vector<tuple<int,int,ex>> result;
+	for (int i=0;i<m.rows();++i)
+	for (int j=symmetry==MatrixSymmetry::none? 0 : i;j<m.cols();++j)
+		if (!m(i,j).is_zero()) result.emplace_back(i+1,j+1,m(i,j));
+	return result;
+}
+
+inline string symmetry_name(MatrixSymmetry symmetry) {
+	switch (symmetry) {
+		case MatrixSymmetry::symmetric: return "symmetric";
+		case MatrixSymmetry::antisymmetric: return "antisymmetric";
+		default: return "general";
+	}
+}
+
+//writes m as e.g. antisymmetric 3x3 {(1,2)=e3,(1,3)=-e2}
+inline ostream& print_sparse(ostream& os, const matrix& m) {
+	auto symmetry=matrix_symmetry(m);
+	os<<symmetry_name(symmetry)<<" "<<m.rows()<<"x"<<m.cols()<<" {";
+	bool first=true;
+	for (auto& entry: nonzero_entries(m,symmetry)) {
+		if (!first) os<<",";
+		first=false;
+		os<<"("<<get<0>(entry)<<","<<get<1>(entry)<<")="<<get<2>(entry);
+	}
+	return os<<"}";
+}
+
+//the index of the word of a stream which is nonzero if each result is to be written out as soon as it is added
+inline int stream_index() {
+	static const int index=ios_base::xalloc();
+	return index;
+}
+inline bool stream_enabled(ios_base& s) {
+	return s.iword(stream_index());
+}
+inline ostream& stream_output(ostream& os) {
+	os.iword(stream_index())=1;
+	return os;
+}
+inline ostream& no_stream_output(ostream& os) {
+	os.iword(stream_index())=0;
+	return os;
+}
+
+inline string json_string(const string& s) {
+	string result="\"";
+	for (char c: s)
+		switch (c) {
+			case '"': result+="\\\""; break;
+			case '\\': result+="\\\\"; break;
+			case '\n': result+="\\n"; break;
+			case '\t': result+="\\t"; break;
+			default:
+				if (static_cast<unsigned char>(c)<0x20) {
+					char escaped[8];
+					snprintf(escaped,sizeof(escaped),"\\u%04x",static_cast<unsigned char>(c));
+					result+=escaped;
+				}
+				else result+=c;
+		}
+	return result+"\"";
+}
+
+/** @brief A JSON value representing x, where matrices and lists are arrays and other expressions are strings printed with the format of os
+ *
+ * If sparse is true, matrices are represented as objects with the fields rows, cols, symmetry and entries, the latter being an array of the nonzero entries [i,j,value],
+ * as listed by nonzero_entries.
+ */
+inline string json_value(const ex& x, const ostream& format, bool sparse=false) {
+	if (is_a<matrix>(x) && sparse) {
+		auto& m=ex_to<matrix>(x);
+		auto symmetry=matrix_symmetry(m);
+		string result="{\"rows\":"+to_string(m.rows())+",\"cols\":"+to_string(m.cols())+",\"symmetry\":"+json_string(symmetry_name(symmetry))+",\"entries\":[";
+		bool first=true;
+		for (auto& entry: nonzero_entries(m,symmetry)) {
+			if (!first) result+=',';
+			first=false;
+			result+='['+to_string(get<0>(entry))+','+to_string(get<1>(entry))+','+json_value(get<2>(entry),format)+']';
+		}
+		return result+"]}";
+	}
+	if (is_a<matrix>(x)) {
+		auto& m=ex_to<matrix>(x);
+		string result="[";
+		for (int i=0;i<m.rows();++i) {
+			if (i) result+=',';
+			result+='[';
+			for (int j=0;j<m.cols();++j) {
+				if (j) result+=',';
+				result+=json_value(m(i,j),format,sparse);
+			}
+			result+=']';
+		}
+		return result+"]";
+	}
+	if (is_a<lst>(x)) {
+		string result="[";
+		for (int i=0;i<x.nops();++i) {
+			if (i) result+=',';
+			result+=json_value(x.op(i),format,sparse);
+		}
+		return result+"]";
+	}
+	stringstream s;
+	s.copyfmt(format);
+	s<<x;
+	return json_string(s.str());
+}
+
+//the elements of a container of expressions as a list, to be stored as a single result
+template<typename Container>
+lst list_of(const Container& elements) {
+	lst result;
+	for (auto& x: elements) result.append(x);
+	return result;
+}
+
+/** @brief The named results of a job, written in the OutputFormat of the stream
+ *
+ * In text format, results are written as soon as they are added, as name=value or as the bare value; in JSON format, the results of a job form an object on a single line,
+ * with matrices and lists as arrays; in archive format, they form a GiNaC archive where each expression is stored with its name. Both are written by finish(),
+ * which is called on destruction unless an exception is being thrown.
+ * Programs emit free-form lines through text(), which only prints in text format, and the corresponding structured data through data(), which is omitted in text format.
+ *
+ * If sparse output is enabled on the stream (see sparse_output), matrices are written as lists of their nonzero entries, only on and above the diagonal when they are
+ * symmetric or antisymmetric.
+ *
+ * If common subexpression elimination is enabled on the stream (see cse_output), text and JSON output are deferred to finish(), where the subexpressions repeated
+ * across the results are replaced by temporaries cse1, cse2,... whose definitions are written first, as cseN=value lines or as a "Common subexpressions" object.
+ *
+ * If streaming is enabled on the stream (see stream_output), each result is a record written out as soon as it is added, taking precedence over common subexpression
+ * elimination: a name=value line in text format, an object {"name":value} on a single line in JSON format. Archive output is not streamed.
+ */
+class Results {
+	enum class Kind {named, value, data, text};
+	struct Entry {
+		Kind kind;
+		string name;
+		ex value;
+	};
+	ostream& os;
+	OutputFormat format;
+	bool streaming;
+	bool deferred;
+	vector<Entry> entries;
+	vector<pair<string,string>> json_fields;
+	archive ar;
+	bool finished=false;
+	void store(const string& name, const ex& value) {
+		if (format==OutputFormat::json && streaming) {
+			os<<'{'<<json_string(name)<<':'<<json_value(value,os,sparse_enabled(os))<<'}'<<endl;
+			end_of_record(os);
+		}
+		else if (format==OutputFormat::json) json_fields.emplace_back(name,json_value(value,os,sparse_enabled(os)));
+		else if (format==OutputFormat::archive) ar.archive_ex(value,name.c_str());
+	}
+	static ostream& print(ostream& os, const ex& value) {
+		if (is_a<matrix>(value) && sparse_enabled(os)) return print_sparse(os,ex_to<matrix>(value));
+		return os<<value;
+	}
+	void write(Kind kind, const string& name, const ex& value) {
+		if (format!=OutputFormat::text) {
+			if (kind!=Kind::text) store(name,value);
+		}
+		else {
+			if (kind==Kind::named) print(os<<name<<"=",value)<<endl;
+			else if (kind==Kind::value) print(os,value)<<endl;
+			else if (kind==Kind::text) os<<name;
+			if (streaming) end_of_record(os);
+		}
+	}
+	void eliminate_common_subexpressions() {
+		exvector values;
+		for (auto& entry: entries) values.push_back(entry.value);
+		auto cse=common_subexpressions(values);
+		if (!cse.temporaries.empty()) {
+			if (format==OutputFormat::text)
+				for (auto& temporary: cse.temporaries) os<<temporary.first<<"="<<temporary.second<<endl;
+			else {
+				string definitions="{";
+				for (int i=0;i<cse.temporaries.size();++i)
+					definitions+=(i? ",":"")+json_string(cse.temporaries[i].first.get_name())+':'+json_value(cse.temporaries[i].second,os);
+				json_fields.emplace_back("Common subexpressions",definitions+"}");
+			}
+		}
+		for (int i=0;i<entries.size();++i)
+			write(entries[i].kind,entries[i].name,cse.expressions[i]);
+	}
+	void emit(Kind kind, const string& name, const ex& value) {
+		if (deferred) entries.push_back(Entry{kind,name,value});
+		else write(kind,name,value);
+	}
+public:
+	explicit Results(ostream& os) : os{os}, format{output_format(os)},
+		streaming{format!=OutputFormat::archive && stream_enabled(os)},
+		deferred{format!=OutputFormat::archive && !streaming && cse_enabled(os)} {}
+	Results(const Results&)=delete;
+	~Results() {
+		if (!uncaught_exceptions()) finish();
+	}
+	//x printed with the format of the stream, e.g. to be used in names
+	string str(const ex& x) const {
+		stringstream s;
+		s.copyfmt(os);
+		s<<x;
+		return s.str();
+	}
+	//a result written as name=value in text format
+	Results& add(const string& name, const ex& value) {
+		emit(Kind::named,name,value);
+		return *this;
+	}
+	//a result written as the bare value in text format
+	Results& add_value(const string& name, const ex& value) {
+		emit(Kind::value,name,value);
+		return *this;
+	}
+	//a result which is only written in the structured formats
+	Results& data(const string& name, const ex& value) {
+		if (format!=OutputFormat::text) emit(Kind::data,name,value);
+		return *this;
+	}
+	//free-form output, only written in text format
+	template<typename Print>
+	Results& text(Print&& print) {
+		if (format!=OutputFormat::text) return *this;
+		if (!deferred) {
+			print(os);
+			if (streaming) end_of_record(os);
+		}
+		else {
+			stringstream s;
+			s.copyfmt(os);
+			print(s);
+			entries.push_back(Entry{Kind::text,s.str(),0});
+		}
+		return *this;
+	}
+	void finish() {
+		if (finished) return;
+		finished=true;
+		if (deferred) eliminate_common_subexpressions();
+		if (format==OutputFormat::json && !streaming) {
+			os<<'{';
+			for (int i=0;i<json_fields.size();++i)
+				os<<(i? ",":"")<<json_string(json_fields[i].first)<<':'<<json_fields[i].second;
+			os<<'}'<<endl;
+		}
+		else if (format==OutputFormat::archive) os<<ar;
+	}
+};
+
+}
+#endif
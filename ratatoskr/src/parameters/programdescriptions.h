@@ -18,6 +18,12 @@
  *  
  *******************************************************************************/
 #include "../output/twocolumnoutput.h"
+#include "../output/bufferedoutput.h"
+#include "../output/compressedoutput.h"
+#include "../output/results.h"
+#include "../batch/jobs.h"
+#include "../batch/workers.h"
+#include "../batch/where.h"
 
 namespace ratatoskr {
 
@@ -25,6 +31,23 @@ inline po::options_description output_options() {
 	po::options_description options;
 	options.add_options()("latex","latex output");
 	options.add_options()("silent","no output");
+	options.add_options()("format",po::value<string>(),"output format: text (default), json (an object per job, on a single line) or archive (a GiNaC archive per job)");
+	options.add_options()("cse","replace the large subexpressions repeated across the results of a job by temporaries cse1, cse2,... defined before the results (text and json formats)");
+	options.add_options()("sparse","write matrices as lists of their nonzero entries, only on and above the diagonal if they are symmetric or antisymmetric");
+	options.add_options()("stream","write out each result as soon as it is computed, as a line name=value in text format or an object on a single line in json format, rather than at the end of the job");
+	options.add_options()("output",po::value<string>(),"write the output to a file instead of standard output");
+	options.add_options()("compress",po::value<string>(),"compress the output file with gzip, as one member per job, whose positions are listed in the file with the suffix .index appended (implied by the suffix .gz)");
+	options.add_options()("flush-interval",po::value<double>(),"write buffered output at least every given number of seconds, rather than only at the end of each job");
+	return options;
+}
+
+inline po::options_description batch_options() {
+	po::options_description options;
+	options.add_options()("batch",po::value<string>(),"file listing one job per line, each given by further command-line arguments (- for standard input)");
+	options.add_options()("workers",po::value<int>()->default_value(1),"number of worker processes for batch runs");
+	options.add_options()("catalog",po::value<string>(),"catalog of Lie algebras used to resolve --lie-algebra @catalog:NAME (default: $RATATOSKR_CATALOG)");
+	options.add_options()("all-from-catalog","run the program once for each Lie algebra in the catalog");
+	options.add_options()("where",po::value<string>(),"skip the jobs whose Lie algebra does not satisfy a comma-separated list of conditions on cheap invariants, e.g. nilpotent,centre>=2");
 	return options;
 }
 
@@ -34,8 +57,35 @@ inline ostream& output_stream(int argc, const char** argv) {
 	po::notify(vm);
 	static stringstream dev_null;
 	if (vm.count("silent")) return dev_null;
-	if (vm.count("latex")) cout<<latex;
-	return cout;
+	//output goes through a large buffer, so that lines ending with endl do not require a system call each
+	static unique_ptr<BufferedOutput> buffer;
+	static ostream os{nullptr};
+	if (!buffer) {
+		auto flush_interval=vm.count("flush-interval")?
+			chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>{vm["flush-interval"].as<double>()}) : chrono::steady_clock::duration::zero();
+		cout.flush();
+		if (vm.count("output")) {
+			auto filename=vm["output"].as<string>();
+			auto compression=vm.count("compress")? compression_from_name(vm["compress"].as<string>()) : compression_from_suffix(filename);
+			buffer=compression==Compression::gzip? compressed_output_to_file(filename,flush_interval) : buffered_output_to_file(filename,flush_interval);
+		}
+		else if (vm.count("compress") && compression_from_name(vm["compress"].as<string>())==Compression::gzip)
+			buffer=make_unique<CompressedOutput>(STDOUT_FILENO,-1,false,flush_interval);
+		else buffer=make_unique<BufferedOutput>(STDOUT_FILENO,false,flush_interval);
+		os.rdbuf(buffer.get());
+	}
+	if (vm.count("latex")) os<<latex;
+	if (vm.count("cse")) os<<cse_output;
+	if (vm.count("sparse")) os<<sparse_output;
+	if (vm.count("stream")) os<<stream_output;
+	if (vm.count("format")) {
+		auto format=vm["format"].as<string>();
+		if (format=="text") os<<text_output;
+		else if (format=="json") os<<json_output;
+		else if (format=="archive") os<<archive_output;
+		else throw InvalidParameter("unknown output format "+format);
+	}
+	return os;
 }
 
 template<typename DescriptionOfCommandLineParameters, typename Program>
@@ -49,10 +99,10 @@ public:
 	bool match(const string& command) const {
 		return command_==command;
 	}
-	void run(int argc, const char** argv) const {
+	void run_job(int argc, const char** argv, ostream& os) const {
 		try {
 			auto parameters=parameterDescription.parametersFromCommandLine(argc,argv);
-			program(parameters,output_stream(argc,argv));
+			program(parameters,os);
 		}
 		catch (const CommandLineError& error) {
 			cerr<<command_<<": "<<program_purpose_<<endl;
@@ -60,6 +110,78 @@ public:
 			cerr<<parameterDescription.human_readable_description();
 		}
 	}
+	//runs the jobs satisfying the predicate, if any, preceding the output of each by the corresponding header, if any
+	void run_batch(int argc, const char** argv, const vector<Job>& jobs, int workers, const optional<InvariantPredicate>& where, const vector<string>& headers={}) const {
+		auto& os=output_stream(argc,argv);
+		auto run_job_to_string=[this,argc,argv,&jobs,&where,&headers,&os] (int i) {
+			auto command_line=job_command_line(argc,argv,jobs[i]);
+			if (where && !satisfies(*where,command_line)) return string{};
+			stringstream output;
+			output.copyfmt(os);
+			if (!headers.empty()) {
+				if (output_format(os)==OutputFormat::text) output<<headers[i]<<endl;
+				else if (output_format(os)==OutputFormat::json) output<<"{\"job\":"<<json_string(headers[i])<<'}'<<endl;
+			}
+			try {
+				run_job(command_line.size(),command_line.data(),output);
+			}
+			catch (const std::exception& error) {
+				cerr<<command_<<": job "<<i+1<<" failed: "<<error.what()<<endl;
+			}
+			return output.str();
+		};
+		run_jobs(jobs.size(),workers,run_job_to_string,os);
+	}
+	//runs the program on each Lie algebra of the catalog, which is only mapped once
+	void run_catalog(int argc, const char** argv, int workers, const optional<InvariantPredicate>& where) const {
+		auto& catalog=default_catalog();
+		vector<Job> jobs;
+		vector<string> names;
+		for (int i=0;i<catalog.size();++i) {
+			names.emplace_back(catalog.name(i));
+			jobs.push_back({"--lie-algebra","@catalog:"+names.back()});
+		}
+		run_batch(argc,argv,jobs,workers,where,names);
+	}
+	void run(int argc, const char** argv) const {
+		po::variables_map vm;
+		ostream* os;
+		try {
+			po::store(po::command_line_parser(argc, argv).options(batch_options()).allow_unregistered().run(), vm);
+			po::notify(vm);
+			if (vm.count("catalog")) open_catalog(vm["catalog"].as<string>());
+			optional<InvariantPredicate> where;
+			if (vm.count("where")) where.emplace(vm["where"].as<string>());
+			if (vm.count("batch")) {
+				run_batch(argc,argv,read_jobs(vm["batch"].as<string>()),vm["workers"].as<int>(),where);
+				return;
+			}
+			if (vm.count("all-from-catalog")) {
+				run_catalog(argc,argv,vm["workers"].as<int>(),where);
+				return;
+			}
+			if (where && !satisfies(*where,vector<const char*>(argv,argv+argc))) return;
+			os=&output_stream(argc,argv);
+		}
+		catch (const po::error& error) {
+			cerr<<command_<<": "<<error.what()<<endl;
+			return;
+		}
+		catch (const CommandLineError& error) {
+			cerr<<command_<<": "<<error.what()<<endl;
+			return;
+		}
+		catch (const InputFileError& error) {
+			cerr<<command_<<": "<<error.what()<<endl;
+			return;
+		}
+		catch (const WorkerError& error) {
+			cerr<<command_<<": "<<error.what()<<endl;
+			return;
+		}
+		run_job(argc,argv,*os);
+		end_of_job(*os);
+	}
 	void run(int argc, char** argv) const {
 		run(argc,const_cast<const char**>(argv));
 	}
@@ -109,6 +231,7 @@ class CommandLineProgramDescriptions {
 		commands<<endl;
 		commands<<"Global options:"<<endl;
 		commands<<output_options();
+		commands<<batch_options();
 		return commands.str();
 	}
 	bool run_matching_program(const string& command, int argc, const char** argv) const {
@@ -0,0 +1,60 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_EINSTEIN_H
+#define RATATOSKR_EINSTEIN_H
+#include "polynomialcurvature.h"
+#include "groebner.h"
+namespace ratatoskr {
+using namespace GiNaC;
+using namespace Wedge;
+
+/** @brief The polynomial system Ric=\lambda g for a metric whose entries are parameters
+ *
+ * Since Ric is invariant under rescaling, the scale is fixed by imposing (det g)^2=1; this also excludes degenerate solutions.
+ * On this locus, D^2Ric is just Ric, so the equations are polynomial. Solutions occur in pairs (g,\lambda), (-g,-\lambda).
+ */
+class EinsteinEquations {
+	PolynomialCurvature curvature;
+	vector<CoCoA::RingElem> equations;
+public:
+	EinsteinEquations(const LieGroup& G, const matrix& g, const ex& lambda) : curvature{G,StructureConstants{G},g,exset{lambda}} {
+		auto& R=curvature.ring();
+		auto ricci=curvature.RicciNumerators();
+		auto Lambda=R.from_ex(lambda);
+		equations.push_back(CoCoA::power(curvature.Determinant(),2)-1);
+		for (int i=0;i<g.rows();++i)
+		for (int j=i;j<g.cols();++j)
+			equations.push_back(ricci[i][j]-Lambda*R.from_ex(g(i,j)));
+	}
+	//each component is described by its reduced Gröbner basis
+	vector<lst> Components() const {
+		auto& R=curvature.ring();
+		vector<lst> result;
+		for (auto& component: factorizing_decomposition(CoCoA::ideal(equations))) {
+			lst basis;
+			for (auto& f: CoCoA::GBasis(component)) basis.append(R.to_ex(f));
+			result.push_back(basis);
+		}
+		return result;
+	}
+};
+
+}
+#endif
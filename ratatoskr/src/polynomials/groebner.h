@@ -0,0 +1,58 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_GROEBNER_H
+#define RATATOSKR_GROEBNER_H
+#include "polynomialring.h"
+namespace ratatoskr {
+
+/** @brief Decomposes the zero locus of an ideal by splitting along factorizations of the elements of its Gröbner basis
+ *
+ * Returns ideals J_1,...,J_m with V(I)=V(J_1)\cup...\cup V(J_m), such that no element of the reduced Gröbner basis of any J_i factors.
+ * Components containing another component are discarded.
+ */
+inline vector<CoCoA::ideal> factorizing_decomposition(const CoCoA::ideal& I) {
+	vector<CoCoA::ideal> components, to_split{I};
+	while (!to_split.empty()) {
+		CoCoA::ideal J=to_split.back();
+		to_split.pop_back();
+		if (CoCoA::IsOne(J)) continue;
+		bool split=false;
+		for (auto& f: CoCoA::GBasis(J)) {
+			auto factorization=CoCoA::factor(f);
+			auto& factors=factorization.myFactors();
+			if (factors.size()==1 && factorization.myMultiplicities()[0]==1) continue;
+			for (auto& h: factors) to_split.push_back(J+CoCoA::ideal(h));
+			split=true;
+			break;
+		}
+		if (!split) components.push_back(J);
+	}
+	vector<CoCoA::ideal> result;
+	for (int i=0;i<components.size();++i) {
+		bool redundant=false;
+		for (int j=0;j<components.size() && !redundant;++j)
+			redundant= j!=i && CoCoA::IsContained(components[j],components[i]) && (j<i || !CoCoA::IsContained(components[i],components[j]));
+		if (!redundant) result.push_back(components[i]);
+	}
+	return result;
+}
+
+}
+#endif
@@ -0,0 +1,170 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_POLYNOMIAL_CURVATURE_H
+#define RATATOSKR_POLYNOMIAL_CURVATURE_H
+#include "polynomialring.h"
+#include "../algebra/structureconstants.h"
+namespace ratatoskr {
+using namespace GiNaC;
+using namespace Wedge;
+
+//the matrix of the metric relative to the frame of the Lie algebra
+inline matrix metric_matrix(const LieGroup& G, const PseudoRiemannianStructure& g) {
+	int n=G.Dimension();
+	matrix m(n,n);
+	for (int i=0;i<n;++i)
+	for (int j=0;j<n;++j)
+		m(i,j)=g.ScalarProduct().OnVectors(G.e()[i],G.e()[j]);
+	return m;
+}
+
+/** @brief Levi-Civita connection and curvature of a left-invariant metric whose entries and structure constants are polynomials
+ *
+ * Everything is computed in a CoCoA polynomial ring with denominators cleared: with D=det g, the Christoffel symbols are stored as
+ * polynomials N^k_{ij}=D\Gamma^k_{ij}, and the curvature as polynomials D^2R^l_{ijk}. Expressions are only converted back to GiNaC on output.
+ *
+ * Conventions: \nabla_{e_i}e_j=\sum_k\Gamma^k_{ij}e_k, R(e_i,e_j)e_k=\sum_l R^l_{ijk}e_l, with R(X,Y)=[\nabla_X,\nabla_Y]-\nabla_{[X,Y]}
+ */
+class PolynomialCurvature {
+	using Tensor3=vector<vector<vector<CoCoA::RingElem>>>;
+	static exset variables(const StructureConstants& c, const matrix& g, exset result) {
+		for (auto& triple: c.triples()) insert_symbols(result,triple.c);
+		for (int i=0;i<g.rows();++i)
+		for (int j=0;j<g.cols();++j)
+			insert_symbols(result,g(i,j));
+		return result;
+	}
+	int n;
+	exvector e;
+	PolynomialRing R;
+	CoCoA::RingElem D;
+	Tensor3 bracket;	//bracket[i][j][k] is the coefficient of e_k in [e_i,e_j]
+	Tensor3 Gamma;	//Gamma[i][j][k]=D\Gamma^k_{ij}
+	vector<vector<Tensor3>> curvature;	//curvature[i][j][k][l]=D^2R^l_{ijk}, only for i<j
+
+	Tensor3 zero_tensor() const {
+		return Tensor3(n,vector<vector<CoCoA::RingElem>>(n,vector<CoCoA::RingElem>(n,R.zero())));
+	}
+	void compute_bracket(const StructureConstants& c) {
+		bracket=zero_tensor();
+		for (auto& triple: c.triples()) {
+			auto coefficient=R.from_ex(triple.c);
+			bracket[triple.i-1][triple.j-1][triple.k-1]-=coefficient;
+			bracket[triple.j-1][triple.i-1][triple.k-1]+=coefficient;
+		}
+	}
+	void compute_connection(const matrix& g) {
+		CoCoA::matrix G=CoCoA::NewDenseMat(R.ring(),n,n);
+		for (int i=0;i<n;++i)
+		for (int j=0;j<n;++j)
+			CoCoA::SetEntry(G,i,j,R.from_ex(g(i,j)));
+		D=CoCoA::det(G);
+		if (CoCoA::IsZero(D)) throw std::invalid_argument("degenerate metric in PolynomialCurvature");
+		CoCoA::matrix adjugate=CoCoA::adj(G);
+		//B[i][j][l]=g([e_i,e_j],e_l)
+		auto B=zero_tensor();
+		for (int i=0;i<n;++i)
+		for (int j=0;j<n;++j)
+		for (int m=0;m<n;++m) {
+			if (CoCoA::IsZero(bracket[i][j][m])) continue;
+			for (int l=0;l<n;++l)
+				B[i][j][l]+=bracket[i][j][m]*G(m,l);
+		}
+		//Koszul formula: 2g(\nabla_{e_i}e_j,e_l)=g([e_i,e_j],e_l)-g([e_j,e_l],e_i)+g([e_l,e_i],e_j)
+		Gamma=zero_tensor();
+		for (int i=0;i<n;++i)
+		for (int j=0;j<n;++j)
+		for (int l=0;l<n;++l) {
+			auto K=(B[i][j][l]-B[j][l][i]+B[l][i][j])/2;
+			if (CoCoA::IsZero(K)) continue;
+			for (int k=0;k<n;++k)
+				Gamma[i][j][k]+=K*adjugate(l,k);
+		}
+	}
+	void compute_curvature() {
+		curvature.resize(n,vector<Tensor3>(n));
+		for (int i=0;i<n;++i)
+		for (int j=i+1;j<n;++j) {
+			auto& Rij=curvature[i][j]=zero_tensor();
+			for (int k=0;k<n;++k)
+			for (int m=0;m<n;++m) {
+				if (!CoCoA::IsZero(Gamma[j][k][m]))
+					for (int l=0;l<n;++l) Rij[k][l]+=Gamma[j][k][m]*Gamma[i][m][l];
+				if (!CoCoA::IsZero(Gamma[i][k][m]))
+					for (int l=0;l<n;++l) Rij[k][l]-=Gamma[i][k][m]*Gamma[j][m][l];
+				if (!CoCoA::IsZero(bracket[i][j][m]))
+					for (int l=0;l<n;++l) Rij[k][l]-=D*bracket[i][j][m]*Gamma[m][k][l];
+			}
+		}
+	}
+public:
+	PolynomialCurvature(const LieGroup& G, const StructureConstants& c, const matrix& g, const exset& extra_variables={}) :
+		n{c.Dimension()}, R{variables(c,g,extra_variables)} {
+		const auto& frame=G.e();
+		e.assign(frame.begin(),frame.end());
+		compute_bracket(c);
+		compute_connection(g);
+		compute_curvature();
+	}
+	//the matrix of one-forms \omega such that \nabla e_j=\sum_k \omega^k_j\otimes e_k
+	matrix ConnectionForm() const {
+		matrix omega(n,n);
+		for (int i=0;i<n;++i)
+		for (int j=0;j<n;++j)
+		for (int k=0;k<n;++k)
+			omega(k,j)+=R.to_ex(Gamma[i][j][k],D)*e[i];
+		return omega;
+	}
+	//the matrix of two-forms \Omega such that \Omega^l_k=\sum_{i<j}R^l_{ijk}e^{ij}
+	matrix CurvatureForm() const {
+		matrix Omega(n,n);
+		auto den=D*D;
+		for (int i=0;i<n;++i)
+		for (int j=i+1;j<n;++j)
+		for (int k=0;k<n;++k)
+		for (int l=0;l<n;++l)
+			Omega(l,k)+=R.to_ex(curvature[i][j][k][l],den)*e[i]*e[j];
+		return Omega;
+	}
+	//the numerators of the Ricci tensor, i.e. the polynomials D^2 Ric(e_j,e_k)
+	vector<vector<CoCoA::RingElem>> RicciNumerators() const {
+		vector<vector<CoCoA::RingElem>> ricci(n,vector<CoCoA::RingElem>(n,R.zero()));
+		for (int j=0;j<n;++j)
+		for (int k=0;k<n;++k)
+		for (int i=0;i<n;++i)
+			if (i<j) ricci[j][k]+=curvature[i][j][k][i];
+			else if (i>j) ricci[j][k]-=curvature[j][i][k][i];
+		return ricci;
+	}
+	matrix Ricci() const {
+		auto numerators=RicciNumerators();
+		auto den=D*D;
+		matrix ricci(n,n);
+		for (int j=0;j<n;++j)
+		for (int k=0;k<n;++k)
+			ricci(j,k)=R.to_ex(numerators[j][k],den);
+		return ricci;
+	}
+	const PolynomialRing& ring() const {return R;}
+	CoCoA::ConstRefRingElem Determinant() const {return D;}
+};
+
+}
+#endif
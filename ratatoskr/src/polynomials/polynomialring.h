@@ -0,0 +1,127 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_POLYNOMIAL_RING_H
+#define RATATOSKR_POLYNOMIAL_RING_H
+#include "CoCoA/library.H"
+namespace ratatoskr {
+using namespace GiNaC;
+using namespace Wedge;
+
+class NotPolynomial : public std::runtime_error {
+public:
+	NotPolynomial(const ex& e) : std::runtime_error{"not a polynomial with rational coefficients: "+to_canonical_string(e)} {}
+};
+
+//CoCoA requires exactly one GlobalManager to exist; Wedge may have created it already
+inline void initialize_cocoa() {
+	static unique_ptr<CoCoA::GlobalManager> manager=[] () -> unique_ptr<CoCoA::GlobalManager> {
+		try {
+			return make_unique<CoCoA::GlobalManager>();
+		}
+		catch (const CoCoA::ErrorInfo&) {
+			return nullptr;
+		}
+	}();
+}
+
+inline void insert_symbols(exset& symbols, const ex& e) {
+	for (auto i=e.preorder_begin();i!=e.preorder_end();++i)
+		if (is_a<symbol>(*i)) symbols.insert(*i);
+}
+
+inline CoCoA::BigInt to_BigInt(const numeric& n) {
+	stringstream s;
+	s<<n;
+	return CoCoA::BigIntFromString(s.str());
+}
+inline numeric to_numeric(const CoCoA::BigInt& n) {
+	stringstream s;
+	s<<n;
+	return numeric{s.str().c_str()};
+}
+
+/** @brief The ring of polynomials with rational coefficients in a given set of GiNaC symbols, represented in CoCoA
+ *
+ * Only used for intermediate computations: conversions from and to GiNaC expressions are meant to take place on input and output.
+ */
+class PolynomialRing {
+	exvector variables_;
+	map<ex,long,ex_is_less> index_;
+	CoCoA::ring ring_;
+	static CoCoA::ring make_ring(long number_of_variables) {
+		initialize_cocoa();
+		return CoCoA::NewPolyRing(CoCoA::RingQQ(),CoCoA::SymbolRange("x",0,max(number_of_variables,1L)-1));
+	}
+	CoCoA::RingElem from_numeric(const numeric& n) const {
+		if (!n.is_rational()) throw NotPolynomial(n);
+		return CoCoA::RingElem(ring_,CoCoA::BigRat(to_BigInt(n.numer()),to_BigInt(n.denom())));
+	}
+public:
+	explicit PolynomialRing(const exset& variables) : variables_(variables.begin(),variables.end()), ring_{make_ring(variables.size())} {
+		for (long i=0;i<variables_.size();++i) index_.emplace(variables_[i],i);
+	}
+	const CoCoA::ring& ring() const {return ring_;}
+	const exvector& variables() const {return variables_;}
+	CoCoA::RingElem zero() const {return CoCoA::RingElem(ring_);}
+	CoCoA::RingElem from_ex(const ex& e) const {
+		if (is_a<numeric>(e)) return from_numeric(ex_to<numeric>(e));
+		else if (is_a<symbol>(e)) {
+			auto i=index_.find(e);
+			if (i==index_.end()) throw NotPolynomial(e);
+			return CoCoA::indet(ring_,i->second);
+		}
+		else if (is_a<add>(e)) {
+			CoCoA::RingElem result(ring_);
+			for (auto& term: e) result+=from_ex(term);
+			return result;
+		}
+		else if (is_a<mul>(e)) {
+			CoCoA::RingElem result=CoCoA::one(ring_);
+			for (auto& factor: e) result*=from_ex(factor);
+			return result;
+		}
+		else if (is_a<power>(e) && e.op(1).info(info_flags::nonnegint))
+			return CoCoA::power(from_ex(e.op(0)),ex_to<numeric>(e.op(1)).to_long());
+		throw NotPolynomial(e);
+	}
+	ex to_ex(CoCoA::ConstRefRingElem f) const {
+		ex result;
+		vector<long> exponents;
+		CoCoA::BigRat q;
+		for (CoCoA::SparsePolyIter i=CoCoA::BeginIter(f);!CoCoA::IsEnded(i);++i) {
+			CoCoA::IsRational(q,CoCoA::coeff(i));
+			CoCoA::exponents(exponents,CoCoA::PP(i));
+			ex monomial=to_numeric(CoCoA::num(q))/to_numeric(CoCoA::den(q));
+			for (int k=0;k<variables_.size();++k)
+				monomial*=pow(variables_[k],exponents[k]);
+			result+=monomial;
+		}
+		return result;
+	}
+	//converts the quotient of two polynomials to a GiNaC expression, after cancelling common factors
+	ex to_ex(CoCoA::ConstRefRingElem numerator, CoCoA::ConstRefRingElem denominator) const {
+		if (CoCoA::IsZero(numerator)) return 0;
+		auto h=CoCoA::gcd(numerator,denominator);
+		return to_ex(numerator/h)/to_ex(denominator/h);
+	}
+};
+
+}
+#endif
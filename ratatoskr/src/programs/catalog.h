@@ -0,0 +1,70 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+using namespace ratatoskr;
+
+namespace MakeCatalog {
+	struct Parameters {
+		string algebras;
+		string catalog;
+	};
+
+	auto parameters_description=make_parameter_description (
+		"algebras","file listing one Lie algebra per line, given by a name followed by its structure constants in the notation of --lie-algebra",&Parameters::algebras,
+		"catalog-file","name of the catalog file to be created",&Parameters::catalog
+	);
+
+	//reads lines of the form NAME STRUCTURE; empty lines and lines starting with # are ignored
+	vector<pair<string,StructureConstants>> read_named_algebras(istream& is) {
+		vector<pair<string,StructureConstants>> result;
+		for (auto& job: read_jobs(is)) {
+			if (job.size()!=2) throw InvalidParameter("expected a name and a Lie algebra, found "+job[0]+(job.size()>2? " "+job[1]+"..." : ""));
+			if (is_file_reference(job[1])) result.emplace_back(job[0],structure_constants_from_reference(job[1].substr(1)));
+			else result.emplace_back(job[0],lie_algebra_structure_constants(job[1]));
+			if (jacobi_violation(result.back().second)) throw InvalidParameter(job[1]+" is not a Lie algebra");
+		}
+		return result;
+	}
+
+	auto program = make_program_description(
+		"make-catalog", "Create a catalog of named Lie algebras, to be used with --catalog",
+		parameters_description, [] (Parameters& parameters, ostream& os) {
+			ifstream input{parameters.algebras};
+			if (!input) throw InvalidParameter("cannot read "+parameters.algebras);
+			vector<pair<string,StructureConstants>> algebras;
+			try {
+				algebras=read_named_algebras(input);
+			}
+			catch (const InputFileError& error) {
+				throw InvalidParameter(error.what());
+			}
+			ofstream output{parameters.catalog,ios::binary};
+			if (!output) throw InvalidParameter("cannot write "+parameters.catalog);
+			try {
+				Catalog::write(output,algebras);
+			}
+			catch (const invalid_argument& error) {
+				throw InvalidParameter(error.what());
+			}
+			Results results{os};
+			results.text([&algebras,&parameters] (ostream& os) {os<<algebras.size()<<" Lie algebras written to "<<parameters.catalog<<endl;});
+			results.data("Lie algebras written",static_cast<int>(algebras.size()));
+		}
+	);
+}
@@ -25,11 +25,24 @@ namespace CovariantDerivative {
 	auto program = make_program_description(
 		"covariant-derivative", "Compute covariant derivative of a differential form with respect to Levi-Civita on a pseudo-Riemannian metric on a Lie algebra",
 		parameters_description, [] (Parameters& parameters, ostream& os) {
-			parameters.G->canonical_print(os)<<endl;
+			Results results{os};
+			results.text([&parameters] (ostream& os) {parameters.G->canonical_print(os)<<endl;});
 			PseudoLeviCivitaConnection omega(parameters.G.get(),*parameters.g);			
+			exvector one_forms(parameters.G->e().begin(),parameters.G->e().end());
+			auto index=index_of_basis(one_forms);
             for (auto X : parameters.G->e()) {                
-                auto nabla_X_u=NormalForm<DifferentialForm>(omega.Nabla<DifferentialForm>(X,parameters.form));
-                os<<"\\nabla_{"<<X<<"}"<<parameters.form<<"="<<nabla_X_u<<endl;
+				ex nabla_X_u;
+				try {
+					//\nabla_X is a derivation, determined by its action on the one-forms e^k
+					vector<BitmaskForm> nabla_X(one_forms.size());
+					for (int k=0;k<one_forms.size();++k)
+						nabla_X[k]=BitmaskForm::from_ex(omega.Nabla<DifferentialForm>(X,one_forms[k]),index);
+					nabla_X_u=extend_to_derivation(BitmaskForm::from_ex(parameters.form,index),nabla_X,false).normalize().to_ex(one_forms);
+				}
+				catch (const std::invalid_argument&) {
+					nabla_X_u=NormalForm<DifferentialForm>(omega.Nabla<DifferentialForm>(X,parameters.form));
+				}
+                results.add("\\nabla_{"+results.str(X)+"}"+results.str(parameters.form),nabla_X_u);
             }
 		}
 	);
@@ -52,18 +52,39 @@ namespace Curvature {
 		return m;
 	}
 
+	//generic metrics are handled in a polynomial ring, unless the structure constants or the metric are not polynomial 
+	unique_ptr<PolynomialCurvature> polynomial_curvature(const LieGroup& G, const PseudoRiemannianStructure& g, const lst& metric_parameters) {
+		if (metric_parameters.nops()==0) return nullptr;
+		try {
+			return make_unique<PolynomialCurvature>(G,StructureConstants{G},metric_matrix(G,g));
+		}
+		catch (const NotPolynomial&) {
+			return nullptr;
+		}
+	}
+
 	auto program = make_program_description(
 		"curvature", "Compute the curvature of a pseudo-Riemannian metric on a Lie algebra",
 		parameters_description, [] (Parameters& parameters, ostream& os) {
-			parameters.G->canonical_print(os)<<endl;
-			for (auto x: parameters.G->e())
-			for (auto y: parameters.G->e())
-				os<<x<<"\\cdot"<<y<<"="<<parameters.g->ScalarProduct().OnVectors(x,y)<<endl;
+			Results results{os};
+			results.text([&parameters] (ostream& os) {
+				parameters.G->canonical_print(os)<<endl;
+				for (auto x: parameters.G->e())
+				for (auto y: parameters.G->e())
+					os<<x<<"\\cdot"<<y<<"="<<parameters.g->ScalarProduct().OnVectors(x,y)<<endl;
+			});
+			results.data("Metric",metric_matrix(*parameters.G,*parameters.g));
 
+			if (auto curvature=polynomial_curvature(*parameters.G,*parameters.g,parameters.symbols)) {
+				results.add("Connection form",curvature->ConnectionForm());
+				results.add("Curvature",curvature->CurvatureForm());
+				results.add("Ricci tensor",curvature->Ricci());
+				return;
+			}
 			PseudoLeviCivitaConnection omega(parameters.G.get(),*parameters.g);
-			os<<"Connection form="<<omega.AsMatrix()<<endl;			
-			os<<"Curvature="<<normal_matrix(omega.CurvatureForm())<<endl;
-			os<<"Ricci tensor="<<ex(omega.RicciAsMatrix()).normal()<<endl;
+			results.add("Connection form",omega.AsMatrix());
+			results.add("Curvature",normal_matrix(omega.CurvatureForm()));
+			results.add("Ricci tensor",ex(omega.RicciAsMatrix()).normal());
 		}
 	);
 
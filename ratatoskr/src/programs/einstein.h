@@ -0,0 +1,56 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+using namespace ratatoskr;
+
+namespace Einstein {
+
+	struct Parameters {
+		unique_ptr<LieGroup> G;
+		unique_ptr<PseudoRiemannianStructure> g;
+		lst symbols;
+	};
+
+	auto parameters_description=make_parameter_description (
+		"lie-algebra","Lie algebra without parameters",lie_algebra(&Parameters::G),
+		alternative("pattern of the metric")(
+			"generic-diagonal-metric", "generic diagonal metric", generic_diagonal_metric(&Parameters::g,&Parameters::G,&Parameters::symbols)
+		)(
+			"generic-metric", "generic metric all of whose nonzero entries are:", generic_metric_from_nonzero_entries (&Parameters::g,&Parameters::G,&Parameters::symbols)
+		)
+	);
+
+	auto program = make_program_description(
+		"einstein", "Compute the Einstein metrics with a given pattern on a Lie algebra, normalized by (det g)^2=1",
+		parameters_description, [] (Parameters& parameters, ostream& os) {
+			Results results{os};
+			results.text([&parameters] (ostream& os) {parameters.G->canonical_print(os)<<endl;});
+			realsymbol lambda{"lambda","\\lambda"};
+			EinsteinEquations equations(*parameters.G,metric_matrix(*parameters.G,*parameters.g),lambda);
+			auto components=equations.Components();
+			results.text([&components] (ostream& os) {
+				if (components.empty()) os<<"No Einstein metrics"<<endl;
+				for (int i=0;i<components.size();++i)
+					os<<"Component "<<i+1<<": "<<components[i]<<endl;
+			});
+			results.data("Components",list_of(components));
+		}
+	);
+
+}
@@ -38,16 +38,26 @@ namespace Killing {
 		)
 	);
 
-	VectorSpace<Spinor> killing_spinors(const LieGroup& G, const PseudoRiemannianStructureByOrthonormalFrame& g, const PseudoLeviCivitaConnection& omega, ex lambda) {
-			VectorSpace<Spinor> spinors;
-			for (int i=0;i<g.DimensionOfSpinorRepresentation();++i)
-				spinors.AddGenerator(g.u(i));
-			ex u=spinors.GenericElement();
-			lst eqns;
+	/** @brief The operators \nabla_{e_i} and e_i\cdot on spinors, computed once and shared among the values of \lambda */
+	struct KillingOperators {
+		vector<SparseMatrix> nabla, clifford;
+		KillingOperators(const LieGroup& G, const PseudoRiemannianStructureByOrthonormalFrame& g, const PseudoLeviCivitaConnection& omega) {
+			CliffordTable table{g};
 			for (auto e_i : G.e()) {
-				GetCoefficients<Spinor>(eqns,omega.Nabla<Spinor>(e_i, u)-lambda*g.CliffordDot(e_i,u));						
+				nabla.push_back(table.NablaMatrix(omega,e_i));
+				clifford.push_back(table.Matrix(e_i));
 			}
-			return spinors.SubspaceFromEquations(eqns.begin(),eqns.end());
+		}
+	};
+
+	VectorSpace<Spinor> killing_spinors(const PseudoRiemannianStructureByOrthonormalFrame& g, const KillingOperators& operators, ex lambda) {
+			SparseMatrix equations(g.DimensionOfSpinorRepresentation());
+			for (int i=0;i<operators.nabla.size();++i)
+				equations.append(SparseMatrix{operators.nabla[i]}.add(operators.clifford[i],-lambda));
+			VectorSpace<Spinor> spinors;
+			for (auto& v : exact_kernel(equations))
+				spinors.AddGenerator(SparseSpinor{std::move(v)}.to_ex(g));
+			return spinors;
 	}
 
 	ex killing_constant(const PseudoLeviCivitaConnection& omega, vector<int> timelike_indices) {
@@ -55,7 +65,7 @@ namespace Killing {
 			int n=ric.cols();
 			auto g=ex_to<matrix>(unit_matrix(n));
 			for (int i: timelike_indices) g(i-1,i-1)=-1;
-			if (!(ric(0,0)*g*g(0,0)-ric).evalm().is_zero_matrix())
+			if (!ZeroTest{}.is_zero_matrix(ex_to<matrix>((ric(0,0)*g*g(0,0)-ric).evalm())))
 				throw std::runtime_error("Einstein metric expected, but ric=" + to_canonical_string(ric));
 			return sqrt(g(0,0)*	ric(0,0)/(4*(n-1)));
 	}
@@ -63,19 +73,30 @@ namespace Killing {
 	auto program = make_program_description(
 		"killing", "Compute the space of invariant Killing spinors for a Riemannian metric on a Lie algebra",
 		parameters_description, [] (Parameters& parameters, ostream& os) {
-			parameters.G->canonical_print(os)<<endl;
-			os<<"timelike indices "<<parameters.g->ScalarProduct().TimelikeIndices()<<endl;
-			PseudoLeviCivitaConnection omega(parameters.G.get(),*parameters.g);			
-			for (auto e: parameters.G->e())			
-			for (auto u: exvector {parameters.g->u(0),parameters.g->u(1)})
-				cout<<e<<"."<<u<<"="<<parameters.g->CliffordDot(e,u)<<endl;
+			Results results{os};
+			results.text([&parameters] (ostream& os) {
+				parameters.G->canonical_print(os)<<endl;
+				os<<"timelike indices "<<parameters.g->ScalarProduct().TimelikeIndices()<<endl;
+				for (auto e: parameters.G->e())
+				for (auto u: exvector {parameters.g->u(0),parameters.g->u(1)})
+					os<<e<<"."<<u<<"="<<parameters.g->CliffordDot(e,u)<<endl;
+			});
+			PseudoLeviCivitaConnection omega(parameters.G.get(),*parameters.g);
 
 
 			ex lambda=killing_constant(omega,parameters.g->ScalarProduct().TimelikeIndices());
-			os<<"Killing spinors for \\lambda="<<lambda<<endl;
-			os<<killing_spinors(*parameters.G,*parameters.g,omega,lambda).e();
-			os<<"Killing spinors for \\lambda="<<-lambda<<endl;
-			os<<killing_spinors(*parameters.G,*parameters.g,omega,-lambda).e();
+			KillingOperators operators(*parameters.G,*parameters.g,omega);
+			results.data("lambda",lambda);
+			for (int sign : {1,-1}) {
+				auto spinors=killing_spinors(*parameters.g,operators,sign*lambda).e();
+				results.text([&lambda,sign,&spinors] (ostream& os) {
+					os<<"Killing spinors for \\lambda="<<sign*lambda<<endl;
+					os<<spinors;
+				});
+				lst spinor_list;
+				for (auto& spinor : spinors) spinor_list.append(spinor);
+				results.data(sign>0? "Killing spinors for lambda" : "Killing spinors for -lambda",spinor_list);
+			}
 		}
 	);
 
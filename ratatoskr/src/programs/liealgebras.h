@@ -35,14 +35,23 @@ namespace ExtDerivative {
 	auto program = make_program_description(
 		"ext-derivative", "Compute the exterior derivative of a form on a Lie algebra",
 		parameters_description, [] (Parameters& parameters, ostream& os) {
-			os<<parameters.G->d(parameters.form)<<endl;
+			exvector one_forms(parameters.G->e().begin(),parameters.G->e().end());
+			ex dform;
+			try {
+				auto form=BitmaskForm::from_ex(parameters.form,index_of_basis(one_forms));
+				dform=BitmaskDifferential{StructureConstants{*parameters.G}}(form).to_ex(one_forms);
+			}
+			catch (const std::invalid_argument&) {
+				dform=parameters.G->d(parameters.form);
+			}
+			Results{os}.add_value("d",dform);
 		}
 	);
 }
 
 namespace ClosedForms {
 	struct Parameters {
-		unique_ptr<AbstractLieGroup<false>> G;
+		unique_ptr<LieGroupHasParameters<false>> G;
 		int p;
 	};
 
@@ -55,7 +64,95 @@ namespace ClosedForms {
 	auto program = make_program_description(
 		"closed-forms", "Compute the space of closed p-forms",
 		parameters_description, [] (Parameters& parameters, ostream& os) {
-			os<<parameters.G->ClosedForms(parameters.p)<<endl;
+			Results results{os};
+			//rational structure constants are handled as a sparse linear system, anything else by Wedge
+			StructureConstants c{*parameters.G};
+			if (c.is_rational()) {
+				auto splitting=closed_forms(*parameters.G,c,parameters.p,job_workers());
+				results.text([&splitting] (ostream& os) {os<<splitting<<endl;});
+				results.data("Closed forms",list_of(splitting.closed));
+				results.data("Complement",list_of(splitting.complement));
+			}
+			else {
+				auto closed_forms=parameters.G->ClosedForms(parameters.p);
+				results.text([&closed_forms] (ostream& os) {os<<closed_forms<<endl;});
+				results.data("Closed forms",list_of(closed_forms.e()));
+			}
+		}
+	);
+}
+
+namespace Cohomology {
+	struct Parameters {
+		unique_ptr<LieGroupHasParameters<false>> G;
+		bool representatives;
+	};
+
+	auto parameters_description=make_parameter_description
+	(
+		"lie-algebra","Lie algebra without parameters",lie_algebra(&Parameters::G),
+		alternative("output")(
+			"betti-numbers","only compute the Betti numbers",generic_option(&Parameters::representatives,[] () {return false;})
+		)
+		(
+			"representatives","also compute closed forms representing a basis of each cohomology group",generic_option(&Parameters::representatives,[] () {return true;})
+		)
+	);
+
+	/** @brief The rank of d:\Lambda^p\to\Lambda^{p+1} and, if requested, closed p-forms representing a basis of the p-th cohomology group
+	 *
+	 * The representatives are the closed forms in the kernel of d:\Lambda^p\to\Lambda^{p+1} that are independent modulo d\Lambda^{p-1}.
+	 */
+	struct CohomologyInDegree {
+		int rank;
+		exvector representatives;
+	};
+
+	CohomologyInDegree cohomology_in_degree(const LieGroup& G, const BitmaskDifferential& d, int p, bool representatives) {
+		auto forms=p_forms(G,p);
+		auto kernel=exact_kernel(differential_matrix(d,p));
+		CohomologyInDegree result{static_cast<int>(forms.size()-kernel.size()),{}};
+		if (representatives) {
+			auto exact_forms=differentials_of_p_forms(d,p-1);
+			SparseMatrix span(forms.size());
+			for (auto& v: exact_forms) span.add_row(v);
+			for (auto& v: kernel) span.add_row(v);
+			for (int i: span.IndependentRows()) {
+				if (i<exact_forms.size()) continue;
+				ex form;
+				for (auto& entry: kernel[i-exact_forms.size()]) form+=entry.second*forms[entry.first];
+				result.representatives.push_back(form);
+			}
+		}
+		return result;
+	}
+
+	auto program = make_program_description(
+		"cohomology", "Compute the Betti numbers of a Lie algebra, and optionally representatives of its cohomology",
+		parameters_description, [] (Parameters& parameters, ostream& os) {
+			int n=parameters.G->Dimension();
+			BitmaskDifferential d{StructureConstants{*parameters.G}};
+			Results results{os};
+			//the degrees are computed in this process: batch runs already distribute the Lie algebras over the workers
+			int previous_rank=0;
+			for (int p=0;p<=n;++p) {
+				auto degree=cohomology_in_degree(*parameters.G,d,p,parameters.representatives);
+				int dimension=binomial(numeric{n},numeric{p}).to_int();
+				results.add("b_"+to_string(p),dimension-degree.rank-previous_rank);
+				previous_rank=degree.rank;
+				if (!parameters.representatives) continue;
+				results.text([&degree,p] (ostream& os) {
+					os<<"H^"<<p<<":";
+					if (degree.representatives.empty()) os<<"No elements";
+					else {
+						os<<"{{"<<endl;
+						for (auto& form: degree.representatives) os<<form<<endl;
+						os<<"}}";
+					}
+					os<<endl;
+				});
+				results.data("H^"+to_string(p),list_of(degree.representatives));
+			}
 		}
 	);
 }
@@ -75,7 +172,11 @@ namespace Subalgebra {
 	auto program = make_program_description(
 		"subalgebra-without-parameters", "Compute the structure constant of a Lie subalgebra",
 		parameters_description, [] (Parameters& parameters, ostream& os) {
-			parameters.H->canonical_print(os)<<endl;
+			Results results{os};
+			results.text([&parameters] (ostream& os) {parameters.H->canonical_print(os)<<endl;});
+			lst differentials;
+			for (auto& e: parameters.H->e()) differentials.append(parameters.H->d(e));
+			results.data("Differentials",differentials);
 		}
 	);
 }
@@ -96,7 +197,11 @@ namespace SubalgebraWithParameters {
 	auto program = make_program_description(
 		"subalgebra-with-parameters", "Compute the structure constant of a Lie subalgebra",
 		parameters_description, [] (Parameters& parameters, ostream& os) {
-			parameters.H->canonical_print(os)<<endl;
+			Results results{os};
+			results.text([&parameters] (ostream& os) {parameters.H->canonical_print(os)<<endl;});
+			lst differentials;
+			for (auto& e: parameters.H->e()) differentials.append(parameters.H->d(e));
+			results.data("Differentials",differentials);
 		}
 	);
 }
@@ -105,6 +210,7 @@ namespace Derivations {
 	struct Parameters {
 		unique_ptr<LieGroupHasParameters<false>> G;
 	};
+
 	auto parameters_description=make_parameter_description
 	(
 		"lie-algebra","Lie algebra without parameters",lie_algebra(&Parameters::G)
@@ -113,8 +219,58 @@ namespace Derivations {
 	auto program = make_program_description(
 		"derivations", "Compute the derivations of a Lie algebra",
 		parameters_description, [] (Parameters& parameters, ostream& os) {
-			GL gl(parameters.G->Dimension());
-			os<<derivations(*parameters.G,gl)<<endl;			
+			//the derivations are printed as matrices acting on the frame, whether or not the structure constants are rational
+			lst result;
+			for (auto& D: derivation_matrices(StructureConstants{*parameters.G},job_workers())) result.append(D);
+			Results{os}.add_value("Derivations",result);
 		}
 	);
-}
\ No newline at end of file
+}
+namespace RandomLieAlgebra {
+	struct Parameters {
+		int dimension;
+		int seed;
+		double density;
+		int count;
+		RandomLieAlgebraType type;
+	};
+
+	auto parameters_description=make_parameter_description
+	(
+		"dimension","dimension of the Lie algebras",&Parameters::dimension,
+		"seed","seed of the random number generator",&Parameters::seed,
+		"density","probability that each closed 2-form is used in the construction of a differential, between 0 and 1",&Parameters::density,
+		"count","number of Lie algebras to generate",&Parameters::count,
+		alternative("type")(
+			"nilpotent","nilpotent Lie algebras, constructed as sequences of central extensions",generic_option(&Parameters::type,[] () {return RandomLieAlgebraType::nilpotent;})
+		)
+		(
+			"solvable","solvable Lie algebras, extending a graded nilpotent Lie algebra by its grading derivation",generic_option(&Parameters::type,[] () {return RandomLieAlgebraType::solvable;})
+		)
+		(
+			"metric","Lie algebras of even dimension with an ad-invariant metric, given by --metric-by-flat",generic_option(&Parameters::type,[] () {return RandomLieAlgebraType::metric;})
+		)
+	);
+
+	auto program = make_program_description(
+		"random-lie-algebra", "Generate random Lie algebras, printing one line per Lie algebra in the format of --batch",
+		parameters_description, [] (Parameters& parameters, ostream& os) {
+			if (parameters.density<0 || parameters.density>1) throw InvalidParameter("density should be between 0 and 1");
+			//the notation of differential forms represents indices up to 51, written as 1,...,9,a,...,z,A,...,P
+			if (parameters.dimension>51) throw InvalidParameter("dimension should be at most 51, the largest index in the notation of differential forms");
+			if (parameters.count<0) throw InvalidParameter("count should be nonnegative");
+			//the output consists of command lines for --batch, which have no structured representation
+			if (output_format(os)!=OutputFormat::text) throw InvalidParameter("random-lie-algebra only supports the text format");
+			RandomLieAlgebraGenerator generator(parameters.seed,parameters.density);
+			try {
+				string flat=parameters.type==RandomLieAlgebraType::metric? " --metric-by-flat "+to_notation(RandomLieAlgebraGenerator::invariant_metric_flat(parameters.dimension)) : "";
+				for (int i=0;i<parameters.count;++i)
+					os<<"--lie-algebra "<<to_notation(generator(parameters.type,parameters.dimension))<<flat<<'\n';
+			}
+			catch (const invalid_argument& error) {
+				throw InvalidParameter(error.what());
+			}
+			os.flush();
+		}
+	);
+}
@@ -41,15 +41,18 @@ namespace Nabla {
 	auto program = make_program_description(
 		"nabla", "Compute covariant derivatives of spinors on a pseudo-Riemannian metric on a Lie algebra",
 		parameters_description, [] (Parameters& parameters, ostream& os) {
-			parameters.G->canonical_print(os)<<endl;
+			Results results{os};
+			results.text([&parameters] (ostream& os) {parameters.G->canonical_print(os)<<endl;});
 			PseudoLeviCivitaConnection omega(parameters.G.get(),*parameters.g);
-			os<<"Connection form="<<omega.AsMatrix()<<endl;            
-            for (auto X : parameters.G->e())
-            for (int i=0;i<parameters.g->DimensionOfSpinorRepresentation();++i) {
-                auto u=parameters.g->u(i);
-                auto nabla_X_u=omega.Nabla<Spinor>(X,u);
-                os<<"\\nabla_{"<<X<<"}"<<u<<"="<<nabla_X_u<<endl;
-            }
+			results.add("Connection form",omega.AsMatrix());
+			CliffordTable table{*parameters.g};
+			for (auto X : parameters.G->e()) {
+				auto columns=table.ConnectionColumns(omega,X);
+				for (int i=0;i<table.DimensionOfSpinorRepresentation();++i) {
+					auto nabla_X_u=SparseSpinor{table.SpinAction(columns,{{i,1}})}.normalize();
+					results.add("\\nabla_{"+results.str(X)+"}"+results.str(table.SpinorBasis()[i]),nabla_X_u.to_ex(*parameters.g));
+				}
+			}
 		}
 	);
 
@@ -60,7 +63,7 @@ namespace NablaSpinor {
 	struct Parameters {
 		unique_ptr<LieGroup> G;
 		unique_ptr<PseudoRiemannianStructureByOrthonormalFrame> g;
-		ex psi;
+		SparseSpinor psi;
 		vector<int> timelike_indices;
 		lst symbols;
 		GlobalSymbols global_symbols;
@@ -80,13 +83,16 @@ namespace NablaSpinor {
 	auto program = make_program_description(
 		"nabla-spinor", "Compute covariant derivatives of a spinor on a pseudo-Riemannian metric on a Lie algebra",
 		parameters_description, [] (Parameters& parameters, ostream& os) {
-			parameters.G->canonical_print(os)<<endl;
+			Results results{os};
+			results.text([&parameters] (ostream& os) {parameters.G->canonical_print(os)<<endl;});
 			PseudoLeviCivitaConnection omega(parameters.G.get(),*parameters.g);
-			os<<"Connection form="<<omega.AsMatrix()<<endl;            
-            for (auto X : parameters.G->e()) {            
-                auto nabla_X_psi=NormalForm<Spinor>(omega.Nabla<Spinor>(X,parameters.psi));
-                os<<"\\nabla_{"<<X<<"}"<<parameters.psi<<"="<<nabla_X_psi<<endl;
-            }
+			results.add("Connection form",omega.AsMatrix());
+			CliffordTable table{*parameters.g};
+			auto psi=parameters.psi.to_ex(*parameters.g);
+			for (auto X : parameters.G->e()) {
+				SparseSpinor nabla_X_psi{table.Nabla(omega,X,parameters.psi.Components())};
+				results.add("\\nabla_{"+results.str(X)+"}"+results.str(psi),nabla_X_psi.normalize().to_ex(*parameters.g));
+			}
 		}
 	);
 
@@ -113,12 +119,18 @@ namespace Clifford {
 	auto program = make_program_description(
 		"clifford", "Compute cliford product on a pseudo-Riemannian metric on a Lie algebra",
 		parameters_description, [] (Parameters& parameters, ostream& os) {
-			parameters.G->canonical_print(os)<<endl;
-            for (auto X : parameters.G->e())
-            for (int i=0;i<parameters.g->DimensionOfSpinorRepresentation();++i) {
-                auto u=parameters.g->u(i);                
-                os<<X<<"\\cdot "<<u<<"="<<parameters.g->CliffordDot(X,u)<<endl;
-            }
+			Results results{os};
+			CliffordTable table{*parameters.g};
+			results.text([&parameters,&table] (ostream& os) {
+				parameters.G->canonical_print(os)<<endl;
+				table.print(os);
+			});
+			//the images of the spinor basis under Clifford multiplication by each element of the orthonormal frame
+			for (auto& E: table.Frame()) {
+				lst images;
+				for (auto& u: table.SpinorBasis()) images.append(table.CliffordDot(E,u));
+				results.data(results.str(E)+"\\cdot",images);
+			}
 		}
 	);
 
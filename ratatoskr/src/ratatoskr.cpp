@@ -24,15 +24,17 @@
 #include "programs/killing.h"
 #include "programs/spinors.h"
 #include "programs/covariantderivative.h"
+#include "programs/einstein.h"
+#include "programs/catalog.h"
 
 using namespace ratatoskr;
 
 auto alternative_programs = alternative_program_descriptions(
 		Convert::program, Derivative::program, PartialDerivative::program, Invert::program,
-		ExtDerivative::program, ClosedForms::program, Subalgebra::program, SubalgebraWithParameters::program, Derivations::program,
+		ExtDerivative::program, ClosedForms::program, Cohomology::program, Subalgebra::program, SubalgebraWithParameters::program, Derivations::program, RandomLieAlgebra::program,
 		Curvature::program, Killing::program, 
 		Nabla::program, NablaSpinor::program, Clifford::program,
-		CovariantDerivative::program
+		CovariantDerivative::program, Einstein::program, MakeCatalog::program
 );
 
 
@@ -19,3 +19,20 @@
  *******************************************************************************/
 #include "parameters/parameters.h"
 #include "conversions/conversions.h"
+#include "algebra/structureconstants.h"
+#include "forms/bitmaskform.h"
+#include "forms/formnotation.h"
+#include "algebra/differentialcomplex.h"
+#include "algebra/closedforms.h"
+#include "algebra/derivations.h"
+#include "polynomials/polynomialcurvature.h"
+#include "polynomials/einstein.h"
+#include "linearalgebra/sparsematrix.h"
+#include "linearalgebra/modular.h"
+#include "linearalgebra/blocks.h"
+#include "linearalgebra/zerotest.h"
+#include "algebra/grading.h"
+#include "algebra/invariants.h"
+#include "algebra/randomliealgebra.h"
+#include "spinors/cliffordtable.h"
+#include "spinors/sparsespinor.h"
@@ -0,0 +1,171 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_CLIFFORD_TABLE_H
+#define RATATOSKR_CLIFFORD_TABLE_H
+#include "../linearalgebra/sparsematrix.h"
+namespace ratatoskr {
+using namespace GiNaC;
+using namespace Wedge;
+
+inline exvector spinor_basis(const PseudoRiemannianStructureByOrthonormalFrame& g) {
+	exvector basis;
+	for (int k=0;k<g.DimensionOfSpinorRepresentation();++k) basis.push_back(g.u(k));
+	return basis;
+}
+
+/** @brief Clifford multiplication by the elements of the orthonormal frame, stored as signed permutations of the spinor basis
+ *
+ * Each element E_a of the orthonormal frame acts as E_a\cdot u_k=\sigma_{ak}u_{\pi_a(k)}, where \sigma_{ak} is one of \pm 1,\pm i.
+ * The table is computed once per metric; multiplying a spinor by a vector then takes O(n\cdot N) operations, N being the dimension of the spinor representation.
+ */
+class CliffordTable {
+	struct SignedImage {
+		int image;
+		ex sign;
+	};
+	exvector frame;
+	vector<int> norms;	//g(E_a,E_a)=\pm 1
+	exvector squares;	//E_a\cdot E_a acts on spinors as multiplication by \pm 1
+	exvector basis;
+	vector<vector<SignedImage>> table;
+	const PseudoRiemannianStructureByOrthonormalFrame* metric;
+public:
+	CliffordTable(const PseudoRiemannianStructureByOrthonormalFrame& g) : basis{spinor_basis(g)}, metric{&g} {
+		const auto& on_frame=g.e();
+		frame.assign(on_frame.begin(),on_frame.end());
+		auto timelike=g.ScalarProduct().TimelikeIndices();
+		auto index=index_of_basis(basis);
+		for (int a=0;a<frame.size();++a) {
+			norms.push_back(find(timelike.begin(),timelike.end(),a+1)==timelike.end()? 1 : -1);
+			vector<SignedImage> images;
+			for (auto& u : basis) {
+				auto image=components_in_basis(g.CliffordDot(frame[a],u),index);
+				if (image.size()!=1) throw std::logic_error("Clifford multiplication by an orthonormal frame should act by signed permutations");
+				images.push_back({image.begin()->first,image.begin()->second});
+			}
+			squares.push_back(images[images[0].image].sign*images[0].sign);
+			table.push_back(std::move(images));
+		}
+	}
+	int Dimension() const {return frame.size();}
+	int DimensionOfSpinorRepresentation() const {return basis.size();}
+	const exvector& Frame() const {return frame;}
+	const exvector& SpinorBasis() const {return basis;}
+
+	//components of a vector relative to the orthonormal frame
+	SparseVector FrameComponents(const ex& X) const {
+		SparseVector result;
+		for (int a=0;a<frame.size();++a) {
+			ex x=(norms[a]*metric->ScalarProduct().OnVectors(X,frame[a])).expand();
+			if (!x.is_zero()) result.emplace(a,x);
+		}
+		return result;
+	}
+	//E_a\cdot\psi, with \psi represented by its components
+	SparseVector CliffordDot(int a, const SparseVector& psi) const {
+		SparseVector result;
+		for (auto& component : psi) {
+			auto& image=table[a][component.first];
+			result.emplace(image.image,image.sign*component.second);
+		}
+		return result;
+	}
+	SparseVector CliffordDot(const ex& X, const SparseVector& psi) const {
+		SparseVector result;
+		for (auto& x : FrameComponents(X))
+			for (auto& component : CliffordDot(x.first,psi))
+				result[component.first]+=x.second*component.second;
+		for (auto i=result.begin();i!=result.end();)
+			if (i->second.expand().is_zero()) i=result.erase(i);
+			else ++i;
+		return result;
+	}
+	ex CliffordDot(const ex& X, const ex& psi) const {
+		ex result;
+		for (auto& component : CliffordDot(X,components_in_basis(psi,index_of_basis(basis))))
+			result+=component.second*basis[component.first];
+		return result;
+	}
+	/* the action on spinors of a skew-symmetric endomorphism A of the tangent space, A(E_b)=\sum_a A_{ab}E_a being given by columns[b];
+	 * it is the element \sum_{a<b} \frac{A_{ab}}{2E_b\cdot E_b} E_a\cdot E_b of the Clifford algebra, the only one in \Lambda^2 satisfying [A\cdot,X\cdot]=A(X)\cdot
+	 */
+	SparseVector SpinAction(const vector<SparseVector>& columns, const SparseVector& psi) const {
+		SparseVector result;
+		for (int b=0;b<columns.size();++b) {
+			auto E_b_psi=CliffordDot(b,psi);
+			for (auto& A_ab : columns[b]) {
+				if (A_ab.first>=b) continue;
+				for (auto& component : CliffordDot(A_ab.first,E_b_psi))
+					result[component.first]+=A_ab.second/(2*squares[b])*component.second;
+			}
+		}
+		for (auto i=result.begin();i!=result.end();)
+			if (i->second.expand().is_zero()) i=result.erase(i);
+			else ++i;
+		return result;
+	}
+	//the columns of \nabla_X relative to the orthonormal frame, as expected by SpinAction
+	vector<SparseVector> ConnectionColumns(const PseudoLeviCivitaConnection& omega, const ex& X) const {
+		vector<SparseVector> columns;
+		for (auto& E: frame) columns.push_back(FrameComponents(omega.Nabla<VectorField>(X,E)));
+		return columns;
+	}
+	//\nabla_X\psi for \psi a left-invariant spinor, computed as the spin lift of \nabla_X acting on the frame
+	SparseVector Nabla(const PseudoLeviCivitaConnection& omega, const ex& X, const SparseVector& psi) const {
+		return SpinAction(ConnectionColumns(omega,X),psi);
+	}
+	//the matrix of \nabla_X relative to the spinor basis
+	SparseMatrix NablaMatrix(const PseudoLeviCivitaConnection& omega, const ex& X) const {
+		auto columns=ConnectionColumns(omega,X);
+		vector<SparseVector> rows(basis.size());
+		for (int k=0;k<basis.size();++k)
+			for (auto& entry : SpinAction(columns,{{k,1}}))
+				rows[entry.first][k]=entry.second;
+		SparseMatrix result(basis.size());
+		for (auto& row: rows) result.add_row(std::move(row));
+		return result;
+	}
+	//the matrix of Clifford multiplication by X relative to the spinor basis
+	SparseMatrix Matrix(const ex& X) const {
+		vector<SparseVector> rows(basis.size());
+		for (auto& x : FrameComponents(X))
+			for (int k=0;k<basis.size();++k) {
+				auto& image=table[x.first][k];
+				rows[image.image][k]+=x.second*image.sign;
+			}
+		SparseMatrix result(basis.size());
+		for (auto& row: rows) result.add_row(std::move(row));
+		return result;
+	}
+	//prints one line for each element of the orthonormal frame, listing the images of the spinor basis
+	void print(ostream& os) const {
+		for (int a=0;a<frame.size();++a) {
+			os<<frame[a]<<"\\cdot: ";
+			for (int k=0;k<basis.size();++k) {
+				if (k) os<<", ";
+				os<<basis[k]<<"->"<<table[a][k].sign*basis[table[a][k].image];
+			}
+			os<<endl;
+		}
+	}
+};
+
+}
+#endif
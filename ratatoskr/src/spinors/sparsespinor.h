@@ -0,0 +1,68 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#ifndef RATATOSKR_SPARSE_SPINOR_H
+#define RATATOSKR_SPARSE_SPINOR_H
+#include "../linearalgebra/sparsematrix.h"
+namespace ratatoskr {
+using namespace GiNaC;
+using namespace Wedge;
+
+/** @brief A spinor represented by its nonzero components relative to the basis u(0),...,u(N-1)
+ *
+ * Since N grows as 2^{[n/2]}, spinors with few nonzero components are stored and manipulated without ever forming a dense sum over the basis.
+ */
+class SparseSpinor {
+	SparseVector components;
+public:
+	SparseSpinor()=default;
+	explicit SparseSpinor(SparseVector components) {
+		for (auto& component : components) add(component.first,component.second);
+	}
+	const SparseVector& Components() const {return components;}
+	bool is_zero() const {return components.empty();}
+	void add(int i, const ex& coefficient) {
+		auto& c=components[i];
+		c=(c+coefficient).expand();
+		if (c.is_zero()) components.erase(i);
+	}
+	SparseSpinor& add(const SparseSpinor& psi, const ex& coefficient=1) {
+		for (auto& component : psi.components) add(component.first,coefficient*component.second);
+		return *this;
+	}
+	SparseSpinor& normalize() {
+		for (auto i=components.begin();i!=components.end();)
+			if ((i->second=i->second.normal()).is_zero()) i=components.erase(i);
+			else ++i;
+		return *this;
+	}
+	//the spinor as a GiNaC expression; only the nonzero components appear in the sum
+	ex to_ex(const PseudoRiemannianStructureByOrthonormalFrame& g) const {
+		ex result;
+		for (auto& component : components) result+=component.second*g.u(component.first);
+		return result;
+	}
+	//the spinor with components relative to a basis indexed by index_of_basis
+	static SparseSpinor from_ex(const ex& psi, const map<ex,int,ex_is_less>& index) {
+		return SparseSpinor{components_in_basis(psi,index)};
+	}
+};
+
+}
+#endif
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include "ratatoskr.h"
+#include <iomanip>
+
+using namespace ratatoskr;
+
+//a coframe of the given dimension, where each element combines elements of the standard coframe with rational and irrational coefficients
+string coframe(int dimension) {
+	auto index=[] (int i) {return string{"123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQ"[i]};};
+	string result;
+	for (int i=0;i<dimension;++i) {
+		if (i) result+=',';
+		result+="[1/"+to_string(i+2)+"]*("+index(i)+"-"+index((i+1)%dimension)+")+[2]*"+index((i+7)%dimension)+"+[1/sqrt(2)]*"+index((i+3)%dimension);
+	}
+	return result;
+}
+
+template<typename Parse>
+double milliseconds_per_parse(const Parse& parse, int repetitions) {
+	auto start=chrono::steady_clock::now();
+	for (int i=0;i<repetitions;++i) parse();
+	chrono::duration<double,milli> elapsed=chrono::steady_clock::now()-start;
+	return elapsed.count()/repetitions;
+}
+
+//compares ParseDifferentialForms with parse_differential_forms on coframes, and the structure constants obtained through Wedge and FormNotationParser on Lie algebras
+int main() {
+	cout<<setw(10)<<"dimension"<<setw(20)<<"coframe, Wedge"<<setw(20)<<"coframe, native"<<setw(24)<<"Lie algebra, Wedge"<<setw(24)<<"Lie algebra, native"<<"   (ms)"<<endl;
+	RandomLieAlgebraGenerator generator{1,0.3};
+	for (int dimension: {8,16,32,51}) {
+		string zeros="0";
+		for (int i=1;i<dimension;++i) zeros+=",0";
+		AbstractLieGroup<false> G{zeros};
+		auto forms=coframe(dimension);
+		auto lie_algebra=to_notation(generator(RandomLieAlgebraType::nilpotent,dimension));
+		int repetitions=max(1,400/dimension);
+		cout<<setw(10)<<dimension
+			<<setw(20)<<milliseconds_per_parse([&] {ParseDifferentialForms(G.e(),forms.c_str());},repetitions)
+			<<setw(20)<<milliseconds_per_parse([&] {parse_differential_forms(G.e(),forms);},repetitions)
+			<<setw(24)<<milliseconds_per_parse([&] {StructureConstants{AbstractLieGroup<false>{lie_algebra}};},repetitions)
+			<<setw(24)<<milliseconds_per_parse([&] {lie_algebra_structure_constants(lie_algebra);},repetitions)<<endl;
+	}
+}
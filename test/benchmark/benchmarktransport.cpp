@@ -0,0 +1,45 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include "ratatoskr.h"
+#include <iomanip>
+
+using namespace ratatoskr;
+
+//compares the throughput of the pipe and shared memory transports of run_jobs, for jobs whose output is a string of the given size
+double throughput(size_t output_size, int jobs, int workers, size_t shared_ring_capacity) {
+	int fd=open("/dev/null",O_WRONLY);
+	BufferedOutput buffer{fd,true};
+	ostream os{&buffer};
+	auto start=chrono::steady_clock::now();
+	run_jobs(jobs,workers,[output_size] (int i) {return string(output_size,'a'+i%26);},os,shared_ring_capacity);
+	chrono::duration<double> elapsed=chrono::steady_clock::now()-start;
+	return output_size*static_cast<double>(jobs)/elapsed.count()/(1<<20);
+}
+
+int main(int argc, char** argv) {
+	int workers=argc>1? atoi(argv[1]) : 4;
+	cout<<"workers: "<<workers<<endl;
+	cout<<setw(12)<<"output size"<<setw(16)<<"pipe (MiB/s)"<<setw(24)<<"shared memory (MiB/s)"<<endl;
+	for (size_t output_size: {size_t{1}<<12,size_t{1}<<16,size_t{1}<<20,size_t{1}<<23}) {
+		int jobs=max<size_t>(workers,(size_t{1}<<30)/output_size);
+		cout<<setw(12)<<output_size<<setw(16)<<throughput(output_size,jobs,workers,0)
+			<<setw(24)<<throughput(output_size,jobs,workers,SharedRing::default_capacity)<<endl;
+	}
+}
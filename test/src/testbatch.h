@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include <cxxtest/TestSuite.h>
+#include "test.h"
+
+#include "parameters/parameters.h"
+
+using namespace ratatoskr;
+
+class BatchTestSuite : public CxxTest::TestSuite
+{
+	static string output_of_job(int i) {
+		return to_string(i)+":"+string(i*100,'x')+"\n";
+	}
+public:
+	void testReadJobs() {
+		stringstream s{"--lie-algebra 0,0,12 --form 3\n\n# comment\n  --p   2\n"};
+		auto jobs=read_jobs(s);
+		TS_ASSERT_EQUALS(jobs.size(),2);
+		TS_ASSERT_EQUALS(jobs[0],(Job{"--lie-algebra","0,0,12","--form","3"}));
+		TS_ASSERT_EQUALS(jobs[1],(Job{"--p","2"}));
+	}
+	void testJobCommandLine() {
+		const char* (argv[]) {"program invocation", "--latex"};
+		auto command_line=job_command_line(std::size(argv),argv,Job{"--p","2"});
+		TS_ASSERT_EQUALS(command_line.size(),4);
+		TS_ASSERT_EQUALS(string{command_line[3]},"2");
+	}
+	void testWorkersPreserveOrder() {
+		string expected;
+		for (int i=0;i<20;++i) expected+=output_of_job(i);
+		for (int workers : {1,3,30}) {
+			stringstream s;
+			run_jobs(20,workers,output_of_job,s);
+			TS_ASSERT_EQUALS(s.str(),expected);
+		}
+	}
+	void testSharedRing() {
+		string expected;
+		for (int i=0;i<20;++i) expected+=output_of_job(i);
+		//small rings force both wrapping around and falling back to pipes
+		for (size_t capacity : {1000,2500,10000})
+		for (int workers : {2,3}) {
+			stringstream s;
+			run_jobs(20,workers,output_of_job,s,capacity);
+			TS_ASSERT_EQUALS(s.str(),expected);
+		}
+	}
+	void testCompressedOutput() {
+		string filename="testcompressed.gz";
+		{
+			auto buffer=compressed_output_to_file(filename,chrono::steady_clock::duration::zero());
+			ostream os{buffer.get()};
+			run_jobs(3,2,output_of_job,os);
+		}
+		string expected;
+		for (int i=0;i<3;++i) expected+=output_of_job(i);
+		auto file=gzopen(filename.c_str(),"rb");
+		TS_ASSERT(file);
+		char data[1024];
+		auto size=gzread(file,data,sizeof(data));
+		gzclose(file);
+		TS_ASSERT_EQUALS(string(data,size),expected);
+		ifstream index{filename+".index"};
+		uint64_t offset, compressed_size, uncompressed_size, expected_offset=0;
+		for (int i=0;i<3;++i) {
+			TS_ASSERT(index>>offset>>compressed_size>>uncompressed_size);
+			TS_ASSERT_EQUALS(offset,expected_offset);
+			TS_ASSERT_EQUALS(uncompressed_size,output_of_job(i).size());
+			expected_offset+=compressed_size;
+		}
+		TS_ASSERT(!(index>>offset));
+		TS_ASSERT_THROWS(compression_from_suffix("census.zst"),InvalidCompression);
+		TS_ASSERT(compression_from_suffix("census.txt")==Compression::none);
+		remove(filename.c_str());
+		remove((filename+".index").c_str());
+	}
+};
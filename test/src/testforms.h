@@ -0,0 +1,227 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include <cxxtest/TestSuite.h>
+#include "test.h"
+
+#include "parameters/parameters.h"
+#include "conversions/conversions.h"
+#include "algebra/structureconstants.h"
+#include "algebra/differentialcomplex.h"
+#include "algebra/closedforms.h"
+#include "algebra/derivations.h"
+#include "algebra/grading.h"
+#include "algebra/invariants.h"
+#include "algebra/randomliealgebra.h"
+
+using namespace GiNaC;
+using namespace Wedge;
+using namespace ratatoskr;
+
+class FormsTestSuite : public CxxTest::TestSuite
+{
+	//whether the forms u and v span the same subspace of the space spanned by basis
+	static bool same_span(const exvector& u, const exvector& v, const exvector& basis) {
+		auto index=index_of_basis(basis);
+		SparseMatrix m(basis.size()), n(basis.size()), both(basis.size());
+		for (auto& x: u) {
+			m.add_row(components_in_basis(x.expand(),index));
+			both.add_row(components_in_basis(x.expand(),index));
+		}
+		for (auto& x: v) {
+			n.add_row(components_in_basis(x.expand(),index));
+			both.add_row(components_in_basis(x.expand(),index));
+		}
+		return exact_rank(m)==exact_rank(both) && exact_rank(n)==exact_rank(both);
+	}
+	static int count_lines(const string& s) {
+		return count(s.begin(),s.end(),'\n');
+	}
+public:
+	void testWedgeSign() {
+		TS_ASSERT_EQUALS(wedge_sign(0b001,0b010),1);
+		TS_ASSERT_EQUALS(wedge_sign(0b010,0b001),-1);
+		TS_ASSERT_EQUALS(wedge_sign(0b101,0b010),-1);
+		TS_ASSERT_EQUALS(wedge_sign(0b110,0b001),1);
+		TS_ASSERT_EQUALS(wedge_sign(FormMask{1}<<63,1),1);
+	}
+	void testWedge() {
+		symbol a{"a"};
+		BitmaskForm alpha{0b01,a};
+		alpha.add(0b10,1);
+		auto alpha_wedge_alpha=alpha.wedge(alpha);
+		TS_ASSERT(alpha_wedge_alpha.is_zero());
+		auto beta=alpha.wedge(BitmaskForm{0b100});
+		TS_ASSERT_EQUALS(beta.Components().size(),2);
+		TS_ASSERT_EQUALS(beta.Components().at(0b101),a);
+	}
+	void testPFormMasks() {
+		TS_ASSERT_EQUALS(p_form_masks(4,2),(vector<FormMask>{0b0011,0b0101,0b1001,0b0110,0b1010,0b1100}));
+		TS_ASSERT_EQUALS(p_form_masks(3,0),vector<FormMask>{0});
+		TS_ASSERT(p_form_masks(3,4).empty());
+	}
+	void testDifferential() {
+		//so(3)+\mathbb{R}^2, with de^1=e^{23}, de^2=-e^{13}, de^3=e^{12}, de^5=e^{45}
+		BitmaskDifferential d{StructureConstants{5,{{2,3,1,1},{1,3,2,-1},{1,2,3,1},{4,5,5,1}}}};
+		for (FormMask A=0;A<32;++A)
+			TS_ASSERT(d(d(BitmaskForm{A})).is_zero());
+		auto de1=d(BitmaskForm{0b1}).Components();
+		TS_ASSERT_EQUALS(de1.size(),1);
+		TS_ASSERT_EQUALS(de1.at(0b110),1);
+		//d(e^{12})=de^1\wedge e^2-e^1\wedge de^2=e^{232}+e^{113}=0
+		TS_ASSERT(d(BitmaskForm{0b11}).is_zero());
+		auto matrix=differential_matrix(d,1);
+		TS_ASSERT_EQUALS(matrix.columns(),5);
+		TS_ASSERT_EQUALS(matrix.rows(),10);
+		TS_ASSERT_EQUALS(matrix.Rank(),4);
+	}
+	void testGrading() {
+		//0,0,12,13
+		Grading grading{StructureConstants{4,{{1,2,3,1},{1,3,4,1}}}};
+		TS_ASSERT_EQUALS(grading.Rank(),2);
+		TS_ASSERT(!Grading::WeightLess{}(grading.weight(FormMask{0b0011}),grading.weight(2)));
+		TS_ASSERT(!Grading::WeightLess{}(grading.weight(2),grading.weight(FormMask{0b0011})));
+		TS_ASSERT(Grading::WeightLess{}(grading.weight(0),grading.weight(1)) || Grading::WeightLess{}(grading.weight(1),grading.weight(0)));
+		//so(3) has no nontrivial grading
+		TS_ASSERT_EQUALS((Grading{StructureConstants{3,{{2,3,1,1},{1,3,2,-1},{1,2,3,1}}}}.Rank()),0);
+	}
+	void testInvariants() {
+		auto heisenberg=lie_algebra_invariants(StructureConstants{AbstractLieGroup<false>{"0,0,12"}});
+		TS_ASSERT_EQUALS(heisenberg.dimension,3);
+		TS_ASSERT_EQUALS(heisenberg.derived_dimension,1);
+		TS_ASSERT_EQUALS(heisenberg.centre_dimension,1);
+		TS_ASSERT_EQUALS(heisenberg.nilpotency_step,2);
+		TS_ASSERT_EQUALS(heisenberg.derived_length,2);
+		TS_ASSERT(heisenberg.unimodular);
+		auto filiform=lie_algebra_invariants(StructureConstants{AbstractLieGroup<false>{"0,0,12,13"}});
+		TS_ASSERT_EQUALS(filiform.nilpotency_step,3);
+		TS_ASSERT_EQUALS(filiform.centre_dimension,1);
+		auto r2=lie_algebra_invariants(StructureConstants{AbstractLieGroup<false>{"0,21"}});
+		TS_ASSERT(!r2.nilpotent());
+		TS_ASSERT(r2.solvable());
+		TS_ASSERT(!r2.unimodular);
+		TS_ASSERT_EQUALS(r2.centre_dimension,0);
+		auto so3=lie_algebra_invariants(StructureConstants{AbstractLieGroup<false>{"23,31,12"}});
+		TS_ASSERT_EQUALS(so3.derived_dimension,3);
+		TS_ASSERT(!so3.solvable());
+		TS_ASSERT(so3.unimodular);
+		InvariantPredicate predicate{"nilpotent, centre>=1, derived-length<3"};
+		TS_ASSERT(predicate(heisenberg));
+		TS_ASSERT(!predicate(r2));
+		TS_ASSERT(InvariantPredicate{"!nilpotent,dim==2"}(r2));
+		TS_ASSERT_THROWS(InvariantPredicate{"dim>=x"},PredicateError);
+		TS_ASSERT_THROWS(InvariantPredicate{"simple"},PredicateError);
+	}
+	void testRandomLieAlgebra() {
+		RandomLieAlgebraGenerator generator{1,0.5};
+		for (auto type : {RandomLieAlgebraType::nilpotent,RandomLieAlgebraType::solvable,RandomLieAlgebraType::metric})
+			for (int i=0;i<10;++i) {
+				auto de=generator(type,6);
+				LieGroupFromStructureConstants G{structure_constants(de)};
+				for (auto& e: G.e()) TS_ASSERT(G.d(G.d(e)).is_zero());
+				auto invariants=lie_algebra_invariants(structure_constants(de));
+				TS_ASSERT(invariants.solvable());
+				if (type!=RandomLieAlgebraType::solvable) TS_ASSERT(invariants.nilpotent());
+			}
+		TS_ASSERT_EQUALS(to_notation(vector<IntegerForm>{{},{},{{0b11,-2}},{{0b101,1},{0b110,3}}}),"0,0,-2*12,13+3*23");
+		TS_ASSERT_EQUALS(to_notation(RandomLieAlgebraGenerator::invariant_metric_flat(4)),"3,4,1,2");
+		TS_ASSERT_THROWS(generator(RandomLieAlgebraType::metric,5),std::invalid_argument);
+	}
+	void testJacobi() {
+		TS_ASSERT_EQUALS(jacobi_violation(StructureConstants{4,{{1,2,3,1},{1,3,4,1}}}),0);
+		TS_ASSERT_EQUALS(jacobi_violation(StructureConstants{4,{{1,2,3,1},{3,4,4,1}}}),4);
+		symbol a{"a"};
+		TS_ASSERT_EQUALS(jacobi_violation(StructureConstants{4,{{1,2,3,a},{1,3,4,a*a}}}),0);
+		TS_ASSERT_EQUALS(jacobi_violation(StructureConstants{4,{{1,2,3,a},{3,4,4,1/(a-1)}}}),4);
+		TS_ASSERT_EQUALS(jacobi_violation(StructureConstants{4,{{1,2,3,a-a*a},{3,4,4,1}}}),4);
+	}
+	void testFormNotation() {
+		AbstractLieGroup<false> G{"0,0,0,0,0,0,0,0,0,0"};
+		auto& e=G.e();
+		symbol a{"a"};
+		for (string forms : {"0,0,12,-21+34", "[1/2]*(1+3),2,4,[-3]*(1-3)", "-12+[a]*34+5*(6+7)+8(9+a)", "1/2*12,(1+2)(3-4),[1/a]*12,1234,0"}) {
+			auto expected=ParseDifferentialForms(e,forms.c_str(),lst{a});
+			auto parsed=parse_differential_forms(e,forms,lst{a});
+			TS_ASSERT_EQUALS(parsed.size(),expected.size());
+			for (int i=0;i<parsed.size();++i)
+				TS_ASSERT((parsed[i]-expected[i]).expand().is_zero());
+		}
+		FormNotationParser parser{4,[] (const string& x) {return ex{x,lst{}};}};
+		auto forms=parser.parse_forms("[2]*12-1/2*43,11,(1+2)(1-2),2*(1+2)");
+		TS_ASSERT_EQUALS(forms.size(),4);
+		TS_ASSERT_EQUALS(forms[0].Components().size(),2);
+		TS_ASSERT_EQUALS(forms[0].Components().at(0b1100),numeric(1,2));
+		TS_ASSERT(forms[1].is_zero());
+		TS_ASSERT_EQUALS(forms[2].Components().at(0b11),-2);
+		TS_ASSERT_EQUALS(forms[3].Components().at(0b10),2);
+		TS_ASSERT_THROWS(parser.parse_forms("15"),FormNotationError);
+		TS_ASSERT_THROWS(parser.parse_forms("[2*12"),FormNotationError);
+		TS_ASSERT_THROWS(parser.parse_forms("1,,2"),FormNotationError);
+		//the indices stop at P, which stands for e^51
+		FormNotationParser parser51{51,[] (const string& x) {return ex{x,lst{}};}};
+		TS_ASSERT_EQUALS(parser51.parse_form("P").Components().count(FormMask{1}<<50),1);
+		try {
+			parser51.parse_form("Q");
+			TS_FAIL("Q is not an index");
+		}
+		catch (const FormNotationError& error) {
+			TS_ASSERT(string{error.what()}.find("invalid index Q")!=string::npos);
+		}
+
+		auto c=structure_constants_from_notation("0,0,2*12,13");
+		TS_ASSERT(c);
+		TS_ASSERT_EQUALS(c->Dimension(),4);
+		TS_ASSERT_EQUALS(c->bracket(1,2,3),-2);
+		TS_ASSERT(!structure_constants_from_notation("0,0,[a]*12"));
+		TS_ASSERT(!structure_constants_from_notation("0,0,1"));
+	}
+	void testClosedForms() {
+		AbstractLieGroup<false> G{"0,0,12,13,14+23"};
+		StructureConstants c{G};
+		for (int p=1;p<=G.Dimension();++p) {
+			auto splitting=closed_forms(G,c,p);
+			auto wedge_closed_forms=G.ClosedForms(p);
+			exvector wedge_basis(wedge_closed_forms.e().begin(),wedge_closed_forms.e().end());
+			TS_ASSERT_EQUALS(splitting.closed.size(),wedge_basis.size());
+			TS_ASSERT(same_span(splitting.closed,wedge_basis,p_forms(G,p)));
+			TS_ASSERT_EQUALS(splitting.closed.size()+splitting.complement.size(),p_forms(G,p).size());
+			//the output has the same layout as Wedge's, e.g. Subspace:{{ followed by one form per line
+			stringstream output, wedge_output;
+			output<<splitting<<endl;
+			wedge_output<<wedge_closed_forms<<endl;
+			TS_ASSERT_EQUALS(count_lines(output.str()),count_lines(wedge_output.str()));
+			TS_ASSERT_EQUALS(output.str().substr(0,10),wedge_output.str().substr(0,10));
+		}
+	}
+	void testDerivations() {
+		//the Heisenberg algebra with rational and irrational structure constants, solved by modular methods and by symbolic elimination respectively
+		AbstractLieGroup<false> G{"0,0,12"}, H{"0,0,[sqrt(2)]*12"};
+		auto rational=derivation_matrices(StructureConstants{G});
+		auto irrational=derivation_matrices(StructureConstants{H});
+		TS_ASSERT_EQUALS(rational.size(),6);
+		TS_ASSERT_EQUALS(irrational.size(),rational.size());
+		for (int i=0;i<min(rational.size(),irrational.size());++i)
+			TS_ASSERT(ex(rational[i].sub(irrational[i])).normal().is_zero_matrix());
+		//each matrix D is a derivation, i.e. D[e_1,e_2]=[De_1,e_2]+[e_1,De_2], the other brackets being zero
+		for (auto& D: irrational) {
+			TS_ASSERT(D(0,2).is_zero() && D(1,2).is_zero());
+			TS_ASSERT((D(2,2)-D(0,0)-D(1,1)).normal().is_zero());
+		}
+	}
+};
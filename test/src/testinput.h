@@ -0,0 +1,83 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include <cxxtest/TestSuite.h>
+#include "test.h"
+
+#include "parameters/parameters.h"
+#include "input/structureconstantsfile.h"
+#include "input/catalog.h"
+
+using namespace GiNaC;
+using namespace Wedge;
+using namespace ratatoskr;
+
+class InputTestSuite : public CxxTest::TestSuite
+{
+	static bool same_structure_constants(const StructureConstants& c1, const StructureConstants& c2) {
+		if (c1.Dimension()!=c2.Dimension() || c1.triples().size()!=c2.triples().size()) return false;
+		for (int i=0;i<c1.triples().size();++i) {
+			auto& t1=c1.triples()[i];
+			auto& t2=c2.triples()[i];
+			if (t1.i!=t2.i || t1.j!=t2.j || t1.k!=t2.k || !(t1.c-t2.c).is_zero()) return false;
+		}
+		return true;
+	}
+public:
+	void testTextStructureConstants() {
+		auto c=parse_structure_constants("# comment\n4\n1 2 3 1\n3 1 4 -1/2 # e^{31} is -e^{13}\n2 1 3 1\n");
+		TS_ASSERT_EQUALS(c.Dimension(),4);
+		TS_ASSERT_EQUALS(c.triples().size(),1);
+		TS_ASSERT_EQUALS(c.bracket(1,3,4),-numeric(1,2));
+		TS_ASSERT_EQUALS(parse_structure_constants("3 1 2 3 123456789012345678901234567890").triples()[0].c,numeric("123456789012345678901234567890"));
+		TS_ASSERT_THROWS(parse_structure_constants("3\n1 1 3 1\n"),InputFileError);
+		TS_ASSERT_THROWS(parse_structure_constants("3\n1 2 4 1\n"),InputFileError);
+		TS_ASSERT_THROWS(parse_structure_constants("3\n1 2 3\n"),InputFileError);
+		TS_ASSERT_THROWS(parse_structure_constants("3\n1 2 3 x\n"),InputFileError);
+	}
+	void testBinaryStructureConstants() {
+		StructureConstants c{5,{{1,2,3,1},{1,3,4,numeric(-2,3)},{2,3,5,7}}};
+		stringstream text, binary;
+		write_structure_constants_text(text,c);
+		write_structure_constants_binary(binary,c);
+		TS_ASSERT(same_structure_constants(parse_structure_constants(text.str()),c));
+		TS_ASSERT(same_structure_constants(parse_structure_constants(binary.str()),c));
+		TS_ASSERT_THROWS(parse_structure_constants(binary.str().substr(0,30)),InputFileError);
+	}
+	void testCatalog() {
+		StructureConstants abelian{3}, heisenberg{3,{{1,2,3,1}}}, r2{2,{{1,2,2,numeric(1,2)}}};
+		string filename="testcatalog.bin";
+		{
+			ofstream file{filename,ios::binary};
+			Catalog::write(file,{{"heisenberg",heisenberg},{"r2",r2},{"abelian",abelian}});
+		}
+		Catalog catalog{filename};
+		TS_ASSERT_EQUALS(catalog.size(),3);
+		TS_ASSERT_EQUALS(catalog.name(0),"abelian");
+		TS_ASSERT_EQUALS(catalog.find("heisenberg"),1);
+		TS_ASSERT_EQUALS(catalog.find("h3"),3);
+		TS_ASSERT(same_structure_constants(catalog.structure_constants("heisenberg"),heisenberg));
+		TS_ASSERT(same_structure_constants(catalog.structure_constants("r2"),r2));
+		TS_ASSERT(same_structure_constants(catalog.structure_constants("abelian"),abelian));
+		TS_ASSERT_THROWS(catalog.structure_constants("h3"),InputFileError);
+		stringstream repeated;
+		TS_ASSERT_THROWS(Catalog::write(repeated,{{"r2",r2},{"r2",abelian}}),std::invalid_argument);
+		remove(filename.c_str());
+	}
+};
@@ -0,0 +1,159 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include <cxxtest/TestSuite.h>
+#include "test.h"
+
+#include "parameters/parameters.h"
+#include "linearalgebra/sparsematrix.h"
+#include "linearalgebra/modular.h"
+#include "linearalgebra/blocks.h"
+#include "linearalgebra/zerotest.h"
+#include "conversions/conversions.h"
+
+using namespace GiNaC;
+using namespace Wedge;
+using namespace ratatoskr;
+
+class LinearAlgebraTestSuite : public CxxTest::TestSuite
+{
+	static ex apply(const SparseVector& row, const SparseVector& v) {
+		ex result;
+		for (auto& entry: row) {
+			auto i=v.find(entry.first);
+			if (i!=v.end()) result+=entry.second*i->second;
+		}
+		return result.normal();
+	}
+public:
+	void testComponentsInBasis() {
+		symbol a{"a"}, x{"x"}, y{"y"}, z{"z"};
+		auto index=index_of_basis({x,y,z});
+		auto v=components_in_basis(2*x+a*z-(x+z)*a,index);
+		TS_ASSERT_EQUALS(v.size(),1);
+		TS_ASSERT_EQUALS(v[0],2-a);
+		TS_ASSERT_THROWS(components_in_basis(x*y,index),std::invalid_argument);
+	}
+	void testIndependentRows() {
+		symbol a{"a"};
+		SparseMatrix m(3);
+		m.add_row({{0,1},{1,a}});
+		m.add_row({{0,2},{1,2*a}});
+		m.add_row({{2,1}});
+		m.add_row({{0,1},{1,a},{2,-1}});
+		m.add_row({{1,1}});
+		TS_ASSERT_EQUALS(m.IndependentRows(),(vector<int>{0,2,4}));
+	}
+	void testModularKernel() {
+		SparseMatrix m(5);
+		m.add_row({{0,numeric(1,3)},{1,2},{3,7}});
+		m.add_row({{0,1},{1,6},{2,numeric(5,11)},{3,21}});
+		m.add_row({{2,numeric(-12345678,999)},{4,numeric(1000003,17)}});
+		m.add_row({{1,1},{4,1}});
+		TS_ASSERT(is_rational(m));
+		auto kernel=modular_kernel(m);
+		auto expected=m.Kernel();
+		TS_ASSERT_EQUALS(kernel.size(),expected.size());
+		for (int i=0;i<kernel.size();++i)
+		for (int j=0;j<5;++j)
+			TS_ASSERT_EQUALS(kernel[i][j],expected[i][j]);
+		TS_ASSERT_EQUALS(exact_rank(m),4);
+		TS_ASSERT_EQUALS(modular_kernel(SparseMatrix{3}).size(),3);
+		symbol a{"a"};
+		m.add_row({{0,a}});
+		TS_ASSERT(!is_rational(m));
+	}
+	void testBlockKernel() {
+		SparseMatrix m(5);
+		m.add_row({{0,1},{3,2}});
+		m.add_row({{1,1},{2,numeric(1,2)}});
+		m.add_row({{4,3},{1,1}});
+		vector<int> blocks{0,1,1,0,1};
+		auto kernel=block_kernel(m,blocks);
+		auto expected=m.Kernel();
+		TS_ASSERT_EQUALS(kernel.size(),expected.size());
+		for (int i=0;i<kernel.size();++i)
+		for (int j=0;j<5;++j)
+			TS_ASSERT_EQUALS(kernel[i][j],expected[i][j]);
+		TS_ASSERT_EQUALS(enumerate_distinct(vector<int>{5,3,5,7}),(vector<int>{0,1,0,2}));
+		TS_ASSERT_EQUALS(deserialize(*make_unique<stringstream>(serialize(kernel))).size(),kernel.size());
+		m.add_row({{0,1},{1,1}});
+		TS_ASSERT_THROWS(block_kernel(m,blocks),std::logic_error);
+	}
+	void testParallelBlockKernel() {
+		//two blocks large enough to be solved by separate workers, and a small one solved in the calling process
+		int size=min_parallel_block_columns;
+		SparseMatrix m(2*size+3);
+		vector<int> blocks;
+		for (int block=0;block<3;++block) {
+			int columns=block<2? size : 3;
+			int first=blocks.size();
+			for (int j=0;j<columns;++j) blocks.push_back(block);
+			for (int j=first;j+2<first+columns;j+=2)
+				m.add_row({{j,1},{j+1,numeric(block+1,j+1)},{j+2,-1}});
+		}
+		auto serial=block_kernel(m,blocks);
+		auto parallel=block_kernel(m,blocks,2);
+		TS_ASSERT_EQUALS(parallel.size(),serial.size());
+		for (int i=0;i<min(parallel.size(),serial.size());++i) {
+			TS_ASSERT_EQUALS(parallel[i].size(),serial[i].size());
+			for (auto& entry: parallel[i])
+				TS_ASSERT((entry.second-serial[i][entry.first]).is_zero());
+		}
+	}
+	void testKernel() {
+		symbol a{"a"};
+		SparseMatrix m(4);
+		m.add_row({{0,1},{1,a},{3,1}});
+		m.add_row({{0,2},{1,2*a},{2,1},{3,2}});
+		m.add_row({{2,3}});
+		TS_ASSERT_EQUALS(m.Rank(),2);
+		auto kernel=m.Kernel();
+		TS_ASSERT_EQUALS(kernel.size(),2);
+		for (auto& v: kernel)
+		for (auto& row: m.row_vectors())
+			TS_ASSERT_EQUALS(apply(row,v),0);
+	}
+	void testStacking() {
+		SparseMatrix A(2), B(2);
+		A.add_row({{0,1}});
+		A.add_row({{1,1}});
+		B.add_row({{1,1}});
+		B.add_row({{0,1}});
+		SparseMatrix C{A};
+		C.add(B,-1);
+		TS_ASSERT_EQUALS(C.Rank(),1);
+		C.append(A);
+		TS_ASSERT_EQUALS(C.rows(),4);
+		TS_ASSERT_EQUALS(C.Rank(),2);
+	}
+	void testZeroTest() {
+		symbol x{"x"}, y{"y"};
+		ZeroTest zero_test;
+		ex zero=pow(x+y,5)/(x-y)-pow(x-y,4)*pow(x+y,5)/pow(x-y,5);
+		TS_ASSERT(zero_test.probably_zero(zero));
+		TS_ASSERT(zero_test.is_zero(zero));
+		TS_ASSERT(!zero_test.probably_zero(pow(x+y,5)-pow(x,5)-pow(y,5)));
+		TS_ASSERT(!zero_test.is_zero(1/(x-1)-1/(y-1)));
+		TS_ASSERT(zero_test.is_zero(sqrt(ex{2})*sqrt(ex{2})-2));
+		TS_ASSERT(!zero_test.probably_zero(sqrt(ex{2})-1));
+		TS_ASSERT(zero_test.is_zero_matrix(matrix{2,2,lst{0,zero,zero,0}}));
+		TS_ASSERT(!zero_test.is_zero_matrix(matrix{2,2,lst{0,zero,x*y,0}}));
+	}
+};
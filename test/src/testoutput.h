@@ -0,0 +1,134 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include <cxxtest/TestSuite.h>
+#include <poll.h>
+#include "test.h"
+
+#include "parameters/parameters.h"
+#include "conversions/conversions.h"
+
+using namespace GiNaC;
+using namespace Wedge;
+using namespace ratatoskr;
+
+class OutputTestSuite : public CxxTest::TestSuite
+{
+public:
+	void testResults() {
+		symbol x{"x"};
+		auto emit=[&x] (ostream& os) {
+			Results results{os};
+			results.text([] (ostream& os) {os<<"header"<<endl;});
+			results.add("Ricci \"tensor\"",matrix{2,2,lst{x,0,0,1}});
+			results.add_value("d",x+1);
+			results.data("list",lst{1,x});
+		};
+		stringstream text, json;
+		emit(text);
+		TS_ASSERT_EQUALS(text.str(),"header\nRicci \"tensor\"=[[x,0],[0,1]]\n1+x\n");
+		json<<json_output;
+		emit(json);
+		TS_ASSERT_EQUALS(json.str(),"{\"Ricci \\\"tensor\\\"\":[[\"x\",\"0\"],[\"0\",\"1\"]],\"d\":\"1+x\",\"list\":[\"1\",\"x\"]}\n");
+		stringstream binary;
+		binary<<archive_output;
+		emit(binary);
+		archive ar;
+		binary>>ar;
+		TS_ASSERT_EQUALS(ar.unarchive_ex(lst{x},"d"),x+1);
+	}
+	void testStreamingOutput() {
+		symbol x{"x"};
+		stringstream json;
+		json<<json_output<<stream_output;
+		{
+			Results results{json};
+			results.add("a",x);
+			results.data("b",lst{1,x});
+		}
+		TS_ASSERT_EQUALS(json.str(),"{\"a\":\"x\"}\n{\"b\":[\"1\",\"x\"]}\n");
+
+		//each record reaches the file descriptor before the job ends
+		int fd[2];
+		TS_ASSERT(!pipe(fd));
+		BufferedOutput buffer{fd[1],true};
+		ostream os{&buffer};
+		os<<stream_output<<cse_output;
+		Results results{os};
+		results.add("a",x+1);
+		//a missing record makes the test fail after a timeout, rather than block
+		pollfd ready{fd[0],POLLIN,0};
+		TS_ASSERT_EQUALS(poll(&ready,1,5000),1);
+		char data[16];
+		ssize_t size=0;
+		if (ready.revents&POLLIN) size=read(fd[0],data,sizeof(data));
+		TS_ASSERT_EQUALS(string(data,max<ssize_t>(size,0)),"a=1+x\n");
+		close(fd[0]);
+	}
+	void testSparseOutput() {
+		symbol x{"x"};
+		matrix ricci{3,3,lst{x,1,0,1,0,0,0,0,2}}, curvature{3,3,lst{0,x,0,-x,0,0,0,0,0}}, general{2,2,lst{0,x,1,0}};
+		TS_ASSERT(matrix_symmetry(ricci)==MatrixSymmetry::symmetric);
+		TS_ASSERT(matrix_symmetry(curvature)==MatrixSymmetry::antisymmetric);
+		TS_ASSERT(matrix_symmetry(general)==MatrixSymmetry::none);
+		symbol y{"y"};
+		matrix rational{2,2,lst{x,1/(x+y)+1/(x-y),2*x/(x*x-y*y),y}};
+		TS_ASSERT(matrix_symmetry(rational)==MatrixSymmetry::symmetric);
+		TS_ASSERT_EQUALS(nonzero_entries(ricci,MatrixSymmetry::symmetric).size(),3);
+		TS_ASSERT_EQUALS(nonzero_entries(general,MatrixSymmetry::none).size(),2);
+		auto emit=[&] (ostream& os) {
+			Results results{os};
+			results.add("Ricci",ricci);
+			results.add("Curvature",curvature);
+			results.add("M",general);
+		};
+		stringstream text, json;
+		text<<sparse_output;
+		emit(text);
+		TS_ASSERT_EQUALS(text.str(),"Ricci=symmetric 3x3 {(1,1)=x,(1,2)=1,(3,3)=2}\nCurvature=antisymmetric 3x3 {(1,2)=x}\nM=general 2x2 {(1,2)=x,(2,1)=1}\n");
+		json<<sparse_output<<json_output;
+		emit(json);
+		TS_ASSERT_EQUALS(json.str(),"{\"Ricci\":{\"rows\":3,\"cols\":3,\"symmetry\":\"symmetric\",\"entries\":[[1,1,\"x\"],[1,2,\"1\"],[3,3,\"2\"]]},"
+			"\"Curvature\":{\"rows\":3,\"cols\":3,\"symmetry\":\"antisymmetric\",\"entries\":[[1,2,\"x\"]]},"
+			"\"M\":{\"rows\":2,\"cols\":2,\"symmetry\":\"general\",\"entries\":[[1,2,\"x\"],[2,1,\"1\"]]}}\n");
+	}
+	void testCommonSubexpressions() {
+		symbol x{"x"}, y{"y"}, z{"z"};
+		ex big=pow(x+y+z,x+y);
+		auto cse=common_subexpressions(exvector{big+1,sin(big),x+y});
+		TS_ASSERT_EQUALS(cse.temporaries.size(),1);
+		TS_ASSERT_EQUALS(cse.temporaries[0].first.get_name(),"cse1");
+		TS_ASSERT_EQUALS(cse.temporaries[0].second,big);
+		TS_ASSERT_EQUALS(cse.expressions[0],cse.temporaries[0].first+1);
+		TS_ASSERT_EQUALS(cse.expressions[1],sin(cse.temporaries[0].first));
+		TS_ASSERT_EQUALS(cse.expressions[2],x+y);
+		TS_ASSERT(common_subexpressions(exvector{x+y,x+y}).temporaries.empty());
+
+		stringstream text;
+		text<<cse_output;
+		{
+			Results results{text};
+			results.add("a",big+1);
+			results.add("b",sin(big));
+		}
+		stringstream expected;
+		expected<<"cse1="<<big<<"\na=1+cse1\nb=sin(cse1)\n";
+		TS_ASSERT_EQUALS(text.str(),expected.str());
+	}
+};
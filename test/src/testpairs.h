@@ -69,11 +69,28 @@ public:
 	}
 	void testSplice() {
 		string s=",123,,321,";
-		TS_ASSERT_EQUALS(splice(s).size(),4);
+		TS_ASSERT_EQUALS(splice(s).size(),5);
 		TS_ASSERT_EQUALS(splice(s)[0],"");
 		TS_ASSERT_EQUALS(splice(s)[1],"123");
 		TS_ASSERT_EQUALS(splice(s)[2],"");
 		TS_ASSERT_EQUALS(splice(s)[3],"321");
-
+		TS_ASSERT_EQUALS(splice(s)[4],"");
+		TS_ASSERT_EQUALS(splice("").size(),1);
+		auto fields=splice_view(s);
+		TS_ASSERT_EQUALS(fields.size(),5);
+		TS_ASSERT_EQUALS(fields[3],"321");
+		TS_ASSERT_EQUALS(fields[3].data(),s.data()+6);
+	}
+	void testFromString() {
+		TS_ASSERT_EQUALS(from_string<int>("-12"),-12);
+		TS_ASSERT_EQUALS(from_string<int>(" +7 "),7);
+		TS_ASSERT_EQUALS(from_string<float>("2.5"),2.5f);
+		TS_ASSERT_EQUALS(from_string<string>("abc"),"abc");
+		TS_ASSERT_THROWS(from_string<int>("12x"),ValueParseError);
+		TS_ASSERT_THROWS(from_string<int>("12x"),CommandLineError);
+		TS_ASSERT_THROWS(from_string<int>(""),ValueParseError);
+		TS_ASSERT_THROWS((pair_from_csv<int,int>("2,x")),PairParseError);
+		TS_ASSERT_THROWS((pair_from_csv<int,int>("2,3,4")),PairParseError);
+		TS_ASSERT_THROWS((pair_from_csv<int,int>("2")),PairParseError);
 	}
 };
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include <cxxtest/TestSuite.h>
+#include "test.h"
+
+#include "parameters/parameters.h"
+#include "conversions/conversions.h"
+#include "algebra/structureconstants.h"
+#include "polynomials/polynomialcurvature.h"
+
+using namespace GiNaC;
+using namespace Wedge;
+using namespace ratatoskr;
+
+class PolynomialsTestSuite : public CxxTest::TestSuite
+{
+	bool is_zero_matrix(const matrix& m) {
+		return ex(m).normal().is_zero_matrix();
+	}
+	//whether D(a-b) is zero, where D clears the denominators of the entries of a and b
+	bool equal_up_to_denominator(const matrix& a, const matrix& b, const ex& D) {
+		auto difference=a.sub(b);
+		for (int i=0;i<difference.rows();++i)
+		for (int j=0;j<difference.cols();++j)
+			if (!(D*difference(i,j)).expand().is_zero()) return false;
+		return true;
+	}
+public:
+	void testStructureConstants() {
+		AbstractLieGroup<false> G("0,0,12,-2*13");
+		StructureConstants c{G};
+		TS_ASSERT_EQUALS(c.Dimension(),4);
+		TS_ASSERT_EQUALS(c.triples().size(),2);
+		TS_ASSERT(c.is_rational());
+		TS_ASSERT_EQUALS(c.bracket(1,2,3),-1);
+		TS_ASSERT_EQUALS(c.bracket(2,1,3),1);
+		TS_ASSERT_EQUALS(c.bracket(1,3,4),2);
+		TS_ASSERT_EQUALS(c.bracket(2,3,4),0);
+	}
+	void testConversions() {
+		symbol x{"x"}, y{"y"};
+		PolynomialRing R{exset{x,y}};
+		ex f=pow(x,3)*y/2-3*y+numeric(5,7);
+		TS_ASSERT_EQUALS((R.to_ex(R.from_ex(f))-f).expand(),0);
+		TS_ASSERT_THROWS(R.from_ex(1/x),NotPolynomial);
+		TS_ASSERT_THROWS(R.from_ex(sqrt(ex(2))),NotPolynomial);
+		TS_ASSERT_EQUALS((R.to_ex(R.from_ex(x*x-y*y),R.from_ex(2*x+2*y))-(x-y)/2).expand(),0);
+	}
+	void testRicciGenericDiagonal() {
+		AbstractLieGroup<false> G("0,0,12,13");
+		lst parameters;
+		matrix g=generic_diagonal_matrix(4,parameters);
+		auto metric=PseudoRiemannianStructureByMatrix::FromMatrixOnFrame(&G,G.e(),g);
+		PseudoLeviCivitaConnection omega(&G,metric);
+		PolynomialCurvature curvature(G,StructureConstants{G},g);
+		TS_ASSERT(is_zero_matrix(curvature.Ricci().sub(omega.RicciAsMatrix())));
+	}
+	void testRicciGenericSymmetric() {
+		LieGroupFamily G("0,0,[a]*12",GlobalSymbols{}.symbols());
+		lst parameters;
+		matrix g=generic_symmetric_matrix(3,parameters);
+		auto metric=PseudoRiemannianStructureByMatrix::FromMatrixOnFrame(&G,G.e(),g);
+		PseudoLeviCivitaConnection omega(&G,metric);
+		PolynomialCurvature curvature(G,StructureConstants{G},g);
+		TS_ASSERT(is_zero_matrix(curvature.Ricci().sub(omega.RicciAsMatrix())));
+	}
+	void testConnectionAndCurvatureGenericDiagonal() {
+		AbstractLieGroup<false> G("0,0,12,13");
+		lst parameters;
+		matrix g=generic_diagonal_matrix(4,parameters);
+		auto metric=PseudoRiemannianStructureByMatrix::FromMatrixOnFrame(&G,G.e(),g);
+		PseudoLeviCivitaConnection omega(&G,metric);
+		PolynomialCurvature curvature(G,StructureConstants{G},g);
+		ex D=g.determinant();
+		TS_ASSERT(equal_up_to_denominator(curvature.ConnectionForm(),omega.AsMatrix(),D));
+		TS_ASSERT(equal_up_to_denominator(curvature.CurvatureForm(),omega.CurvatureForm(),D*D));
+	}
+};
@@ -0,0 +1,70 @@
+/*******************************************************************************
+ *  Copyright (C) 2022 by Diego Conti diego.conti@unipi.it 
+ *  This file is part of Ratatoskr.                          
+ *  Ratatoskr is free software; you can redistribute it and/or modify         
+ *  it under the terms of the GNU General Public License as published by  
+ *  the Free Software Foundation; either version 3 of the License, or     
+ *  (at your option) any later version.                                   
+ *                                                                          
+ *  Ratatoskr is distributed in the hope that it will be useful,              
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of        
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         
+ *  GNU General Public License for more details.                          
+ *                                                                           
+ *  You should have received a copy of the GNU General Public License     
+ *  along with Wedge; if not, write to the                                
+ *   Free Software Foundation, Inc.,                                       
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             
+ *  
+ *******************************************************************************/
+#include <cxxtest/TestSuite.h>
+#include "test.h"
+
+#include "parameters/parameters.h"
+#include "spinors/sparsespinor.h"
+#include "spinors/cliffordtable.h"
+#include "conversions/conversions.h"
+
+using namespace GiNaC;
+using namespace Wedge;
+using namespace ratatoskr;
+
+class SpinorsTestSuite : public CxxTest::TestSuite
+{
+public:
+	void testSparseSpinor() {
+		symbol a{"a"};
+		SparseSpinor psi{{{0,a},{3,1}}};
+		psi.add(SparseSpinor{{{0,-a},{2,2}}});
+		TS_ASSERT_EQUALS(psi.Components().size(),2);
+		TS_ASSERT_EQUALS(psi.Components().at(2),2);
+		psi.add(psi,-1);
+		TS_ASSERT(psi.is_zero());
+	}
+	void testParseSpinorComponents() {
+		auto dense=parse_spinor_components("1,0,0,2",8);
+		auto sparse=parse_spinor_components("0:1,3:2",8);
+		TS_ASSERT_EQUALS(dense.size(),2);
+		TS_ASSERT_EQUALS(sparse.size(),2);
+		TS_ASSERT_EQUALS(dense.at(3),sparse.at(3));
+		TS_ASSERT_EQUALS(parse_spinor_components("5:1,5:-1",8).size(),0);
+		TS_ASSERT_THROWS(parse_spinor_components("8:1",8),ConversionError);
+		TS_ASSERT_THROWS(parse_spinor_components("1,2,3",2),ConversionError);
+		TS_ASSERT_THROWS(parse_spinor_components("x:1",8),ConversionError);
+	}
+	void testNablaAgreesWithLeviCivita() {
+		AbstractLieGroup<false> G{"0,-12,-13,-14+23"};
+		for (auto timelike_indices : {vector<int>{}, vector<int>{2}}) {
+			auto g=PseudoRiemannianStructureByOrthonormalFrame::FromTimelikeIndices(&G,G.e(),timelike_indices,CliffordConvention::STANDARD);
+			PseudoLeviCivitaConnection omega(&G,g);
+			CliffordTable table{g};
+			auto index=index_of_basis(table.SpinorBasis());
+			for (auto X : G.e())
+			for (int i=0;i<table.DimensionOfSpinorRepresentation();++i) {
+				SparseSpinor nabla_X_u{table.Nabla(omega,X,{{i,1}})};
+				nabla_X_u.add(SparseSpinor::from_ex(omega.Nabla<Spinor>(X,g.u(i)),index),-1);
+				TS_ASSERT(nabla_X_u.normalize().is_zero());
+			}
+		}
+	}
+};
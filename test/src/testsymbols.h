@@ -108,5 +108,21 @@ public:
 		TS_ASSERT_EQUALS(parameters.x,parameters.symbols.symbols().op(3)+parameters.symbols.symbols().op(4));
 
 	}
+	void testExpressionParser() {
+		GlobalSymbols global;
+		TS_ASSERT_EQUALS(&global.symbols(),&GlobalSymbols{}.symbols());
+		ex a=global.by_name("a"), phi=global.by_name("phi");
+		TS_ASSERT_THROWS(global.by_name("e1"),NoSymbolWithName);
+		Symbols symbols{global};
+		TS_ASSERT_EQUALS(symbols.ex_from_string("a+phi"),a+phi);
+		TS_ASSERT_EQUALS(symbols.ex_from_string("2*a"),2*a);
+		TS_ASSERT_THROWS(symbols.ex_from_string("e1"),ParseError);
+		TS_ASSERT_EQUALS(symbols.ex_from_string("a^2"),pow(a,2));
+		symbol x{"x"};
+		ExpressionParser parser{lst{x}};
+		for (int i=0;i<10;++i)
+			TS_ASSERT_EQUALS(parser(to_string(i)+"*x"),i*x);
+		TS_ASSERT_EQUALS(parse_expressions("x,a",lst{x,a}),(exvector{x,a}));
+	}
 
 };